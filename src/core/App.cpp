@@ -3,25 +3,105 @@
 #include "engine/DebugUI.h"
 #include "platform/SdlPlatform.h"
 #include "engine/DebugState.h"
+#include "engine/AllocTracker.h"
+#include "engine/Profiler.h"
+#include "engine/Counters.h"
+#include "engine/BinaryStream.h"
+#include "engine/Log.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
 #include <cstdio>
+#include <memory>
+#include <vector>
 
-static SdlPlatform g_platform;
-DebugState dbg;
+#include <fcntl.h>
+#if defined(_WIN32)
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+// Double-buffered checkpoints: one is being written while the other holds
+// the last complete state, which the crash handler dumps.
+static std::vector<uint8_t> s_checkpoints[2];
+static std::atomic<int> s_lastCheckpoint{ -1 };
+static int s_crashFd = -1;      // opened up front: the handler can't open files
+
+#if defined(_WIN32)
+static int OpenCrashFile(const char* path) { return _open(path, _O_WRONLY | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE); }
+static void CloseCrashFile(int fd) { _close(fd); }
+#else
+static int OpenCrashFile(const char* path) { return open(path, O_WRONLY | O_CREAT, 0644); }
+static void CloseCrashFile(int fd) { close(fd); }
+#endif
+
+// Async-signal-safe: raw write(2)/lseek/ftruncate only, no stdio or allocation.
+static void WriteCrashFile(int fd, const uint8_t* data, size_t size) {
+#if defined(_WIN32)
+    _lseek(fd, 0, SEEK_SET);
+    _chsize(fd, (long)size);
+    while (size > 0) {
+        const int n = _write(fd, data, (unsigned)std::min(size, (size_t)1 << 30));
+        if (n <= 0) return;
+        data += n;
+        size -= (size_t)n;
+    }
+#else
+    if (lseek(fd, 0, SEEK_SET) != 0 || ftruncate(fd, (off_t)size) != 0) return;
+    while (size > 0) {
+        const ssize_t n = write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;
+        data += n;
+        size -= (size_t)n;
+    }
+#endif
+}
+
+static void OnCrashSignal(int sig) {
+    const int last = s_lastCheckpoint.load();
+    if (last >= 0 && s_crashFd >= 0) {
+        const std::vector<uint8_t>& state = s_checkpoints[last];
+        WriteCrashFile(s_crashFd, state.data(), state.size());
+    }
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+
+App::App() : m_dbg(std::make_unique<DebugState>()) {}
+App::~App() = default;
 
 bool App::Init(const AppConfig& cfg) {
-    if (!g_platform.Init(cfg.windowWidth, cfg.windowHeight, cfg.title)) {
+    if (!m_platform.Init(cfg.windowWidth, cfg.windowHeight, cfg.title)) {
         std::printf("[ERROR] Platform init failed\n");
         return false;
     }
+    m_cfg = cfg;
+    m_platform.SetMaxFrameDt(cfg.maxFrameDt);
+
+    // Internal resolution (dynamic resolution needs a target even at native size)
+    int renderW = cfg.renderWidth, renderH = cfg.renderHeight;
+    if ((renderW <= 0 || renderH <= 0) && cfg.dynamicResolution) {
+        m_platform.GetWindowSize(renderW, renderH);
+    }
+    if (renderW > 0 && renderH > 0) {
+        m_platform.SetRenderResolution(renderW, renderH);
+    }
     m_running = true;
     return true;
 }
 
 void App::Run() {
     std::printf("[INFO] Entering main loop\n");
+    DebugState& dbg = *m_dbg;
 
     Game game;
-    if (!game.Init(g_platform)) {
+    if (!game.Init(m_platform)) {
         std::printf("[ERROR] Game::Init failed. Check assets path (assets/player.bmp) and config.\n");
         m_running = false;
         return;
@@ -29,35 +109,170 @@ void App::Run() {
 
 
     DebugUI debugUI;
-    if (!debugUI.Init(g_platform)) {
+    if (!debugUI.Init(m_platform)) {
         std::printf("[ERROR] DebugUI init failed\n");
         return;
     }
 
-    g_platform.SetEventCallback(&DebugUI::OnSdlEvent, &debugUI);
+    m_platform.SetEventCallback(&DebugUI::OnSdlEvent, &debugUI);
+
+    if (m_cfg.loadStatePath) {
+        std::vector<uint8_t> state;
+        if (ReadBinaryFile(m_cfg.loadStatePath, state) && game.LoadState(state)) {
+            LOG_INFO(LogCategory::Core, "Loaded state %s (%zu bytes)", m_cfg.loadStatePath, state.size());
+        }
+        else {
+            LOG_WARN(LogCategory::Core, "Could not load state %s", m_cfg.loadStatePath);
+        }
+    }
+
+    // Deterministic runs: throttling reacts to measured cost, so it's off
+    // (catch-up drops time instead, which only changes how many steps run).
+    const bool degradeBeforeDrop = m_cfg.degradeBeforeDrop && !m_cfg.deterministic;
+    dbg.deterministic = m_cfg.deterministic;
+    FILE* hashLog = nullptr;
+    if (m_cfg.deterministic && m_cfg.hashLogPath) {
+        hashLog = std::fopen(m_cfg.hashLogPath, "w");
+        if (!hashLog) LOG_WARN(LogCategory::Core, "Could not open hash log %s", m_cfg.hashLogPath);
+    }
+    uint64_t stepIndex = 0;
 
     // Fixed timestep simulation parameters
-    const float fixedDt = 1.0f / 60.0f;
+    const float tickRate = std::max(1.0f, m_cfg.tickRate);
+    const float fixedDt = 1.0f / tickRate;
+
+    // Periodic checkpoints (only when there is somewhere to write them)
+    const int checkpointTicks = std::max(1, (int)std::lround(m_cfg.checkpointSeconds * tickRate));
+    int ticksSinceCheckpoint = 0;
+    if (m_cfg.statePath) {
+        // Not truncated here: the previous state stays until a checkpoint replaces it.
+        s_crashFd = OpenCrashFile(m_cfg.statePath);
+        if (s_crashFd >= 0) {
+            for (int sig : { SIGSEGV, SIGABRT, SIGFPE, SIGILL }) std::signal(sig, OnCrashSignal);
+        }
+        else {
+            LOG_WARN(LogCategory::Core, "Could not open %s, crashes won't save state", m_cfg.statePath);
+        }
+    }
+    const int maxSubsteps = std::max(1, m_cfg.maxSubsteps);
     float accumulator = 0.0f;
 
+    // Catch-up bookkeeping
+    using Clock = std::chrono::steady_clock;
+    constexpr float kMaxRepathScale = 8.0f;
+    float dilationReal = 0.0f;      // real seconds in the current window
+    float dilationSim = 0.0f;       // simulated seconds in the current window
+    float onBudgetSeconds = 0.0f;   // how long we've kept up since last throttle change
+
+    dbg.tickRate = tickRate;
+    dbg.maxSubsteps = maxSubsteps;
+    dbg.updateBudgetMs = fixedDt * 1000.0f;
+    for (FrameTimeHistory* h : { &dbg.frameTimes, &dbg.updateTimes, &dbg.renderTimes, &dbg.presentTimes }) {
+        h->SetBudget(dbg.updateBudgetMs);
+    }
+
+    const char* tracePath = m_cfg.tracePath ? m_cfg.tracePath : "mini_engine_trace.json";
+    bool prevF9 = false;
+
+    // Dynamic resolution: drop a step quickly when over target, climb back slowly
+    constexpr float kRenderScaleStep = 0.125f;
+    const float minRenderScale = std::clamp(m_cfg.dynamicResMinScale, 0.25f, 1.0f);
+    float renderScaleCooldown = 0.0f;
+    m_platform.GetWindowSize(dbg.renderW, dbg.renderH);
+
     while (m_running) {
+        ProfileZone frameZone("Frame");
+
         // ---- Poll platform ----
         SdlFrameData frame{};
-        if (!g_platform.Pump(frame))
-            break;
+        {
+            PROFILE_ZONE("Pump");
+            if (!m_platform.Pump(frame))
+                break;
+        }
+
+        // ---- Trace dump (F9, edge-triggered) ----
+        const bool f9Now = frame.input.Down(Key::F9);
+        if (f9Now && !prevF9) {
+            Profiler::WriteChromeTrace(tracePath, m_cfg.traceSeconds);
+        }
+        prevF9 = f9Now;
 
         dbg.dt = frame.dtSeconds;
+        // Real frame time: a hitch must show up in full, not capped at the dt clamp.
+        dbg.frameTimes.Push((frame.dtSeconds + frame.clampedSeconds) * 1000.0f);
         dbg.fps = (frame.dtSeconds > 0.0f) ? (1.0f / frame.dtSeconds) : 0.0f;
 
+        // ---- Hot reload (between frames, never inside a tick) ----
+        game.ProcessAssetChanges(m_platform, dbg);
+
         // ---- Fixed timestep update ----
         accumulator += frame.dtSeconds;
+        dbg.droppedSeconds += frame.clampedSeconds;
 
-        // Prevent spiral of death if the app hitches
-        if (accumulator > 0.25f) accumulator = 0.25f;
+        int steps = 0;
+        while (accumulator >= fixedDt && steps < maxSubsteps) {
+            PROFILE_ZONE("Update");
+            const Clock::time_point t0 = Clock::now();
+            game.Update(m_platform, frame.input, fixedDt, dbg);
+            const float ms = std::chrono::duration<float, std::milli>(Clock::now() - t0).count();
+
+            dbg.updateTimes.Push(ms);
+
+            // Smoothed cost so a single spike doesn't flip the throttle
+            dbg.updateMs = (dbg.updateMs > 0.0f) ? (dbg.updateMs * 0.9f + ms * 0.1f) : ms;
 
-        while (accumulator >= fixedDt) {
-            game.Update(g_platform, frame.input, fixedDt, dbg);
             accumulator -= fixedDt;
+            ++steps;
+            ++stepIndex;
+
+            if (m_cfg.deterministic) {
+                dbg.stateHash = game.ComputeStateHash();
+                if (hashLog) std::fprintf(hashLog, "%llu %016llx\n", (unsigned long long)stepIndex, (unsigned long long)dbg.stateHash);
+            }
+
+            if (m_cfg.statePath && ++ticksSinceCheckpoint >= checkpointTicks) {
+                ticksSinceCheckpoint = 0;
+                const int next = (s_lastCheckpoint.load() == 0) ? 1 : 0;
+                game.SaveState(s_checkpoints[next]);
+                s_lastCheckpoint.store(next);
+            }
+        }
+        dbg.substeps = steps;
+
+        // Prevent spiral of death: if we hit the substep cap, either throttle AI
+        // (and carry up to one frame's worth of backlog into the next frame)
+        // or drop the excess time. Anything not carried is reported as dropped.
+        if (accumulator >= fixedDt) {
+            onBudgetSeconds = 0.0f;
+            const bool canThrottle = degradeBeforeDrop && dbg.aiRepathScale < kMaxRepathScale;
+            if (canThrottle) {
+                dbg.aiRepathScale = std::min(kMaxRepathScale, dbg.aiRepathScale * 2.0f);
+                const float carried = std::min(accumulator, fixedDt * (float)maxSubsteps);
+                dbg.droppedSeconds += accumulator - carried;
+                accumulator = carried;
+            }
+            else {
+                const float pending = std::floor(accumulator / fixedDt) * fixedDt;
+                accumulator -= pending;
+                dbg.droppedSeconds += pending;
+            }
+        }
+        else if (dbg.aiRepathScale > 1.0f && dbg.updateMs < dbg.updateBudgetMs * 0.5f) {
+            // Back under budget for a while -> relax the throttle one notch
+            onBudgetSeconds += frame.dtSeconds;
+            if (onBudgetSeconds >= 1.0f) {
+                onBudgetSeconds = 0.0f;
+                dbg.aiRepathScale = std::max(1.0f, dbg.aiRepathScale * 0.5f);
+            }
+        }
+
+        dilationReal += frame.dtSeconds + frame.clampedSeconds;
+        dilationSim += (float)steps * fixedDt;
+        if (dilationReal >= 1.0f) {
+            dbg.timeDilation = dilationSim / dilationReal;
+            dilationReal = 0.0f;
+            dilationSim = 0.0f;
         }
 
         if (game.RequestedQuit())
@@ -66,21 +281,94 @@ void App::Run() {
         const float alpha = (fixedDt > 0.0f) ? (accumulator / fixedDt) : 0.0f;
 
         // ---- Render ----
-        g_platform.BeginFrame();
+        const Clock::time_point renderStart = Clock::now();
+        m_platform.BeginFrame();
 
-        debugUI.BeginFrame();
-        debugUI.Draw(dbg);     // NEW
-        game.Render(g_platform, alpha, dbg); // well pass dbg into Render
-        debugUI.EndFrame(g_platform);
+        {
+            PROFILE_ZONE("ImGui");
+            debugUI.BeginFrame(dbg);
+            debugUI.Draw(dbg);     // NEW
+        }
+        const Clock::time_point sceneStart = Clock::now();
+        {
+            PROFILE_ZONE("Render");
+            game.Render(m_platform, alpha, dbg); // well pass dbg into Render
+        }
+        {
+            PROFILE_ZONE("ResolveScene");
+            m_platform.ResolveScene();
+        }
+        const float sceneMs = std::chrono::duration<float, std::milli>(Clock::now() - sceneStart).count();
+        dbg.sceneMs = (dbg.sceneMs > 0.0f) ? (dbg.sceneMs * 0.9f + sceneMs * 0.1f) : sceneMs;
+        {
+            PROFILE_ZONE("ImGui.Render");
+            debugUI.EndFrame(m_platform);
+        }
+
+        const Clock::time_point presentStart = Clock::now();
+        {
+            PROFILE_ZONE("Present");
+            m_platform.EndFrame();
+        }
+        const Clock::time_point presentEnd = Clock::now();
+        dbg.renderTimes.Push(std::chrono::duration<float, std::milli>(presentStart - renderStart).count());
+        dbg.presentTimes.Push(std::chrono::duration<float, std::milli>(presentEnd - presentStart).count());
+
+        // ---- Dynamic resolution (takes effect next frame) ----
+        if (m_cfg.dynamicResolution && m_platform.HasSceneTarget()) {
+            renderScaleCooldown -= frame.dtSeconds;
+            const float scale = m_platform.RenderScale();
+            if (renderScaleCooldown <= 0.0f) {
+                if (dbg.sceneMs > m_cfg.dynamicResTargetMs && scale > minRenderScale) {
+                    m_platform.SetRenderScale(std::max(minRenderScale, scale - kRenderScaleStep));
+                    renderScaleCooldown = 0.25f;
+                }
+                else if (dbg.sceneMs < m_cfg.dynamicResTargetMs * 0.6f && scale < 1.0f) {
+                    m_platform.SetRenderScale(std::min(1.0f, scale + kRenderScaleStep));
+                    renderScaleCooldown = 1.0f;
+                }
+            }
+        }
+        dbg.renderScale = m_platform.RenderScale();
+
+        AllocTracker::EndFrame();
+        Counters::EndFrame();
+    }
 
+    if (hashLog) std::fclose(hashLog);
 
-        g_platform.EndFrame();
+    if (m_cfg.statePath) {
+        std::vector<uint8_t> state;
+        game.SaveState(state);
+        if (WriteBinaryFile(m_cfg.statePath, state)) {
+            LOG_INFO(LogCategory::Core, "Saved state %s (%zu bytes)", m_cfg.statePath, state.size());
+        }
+    }
+    if (s_crashFd >= 0) {
+        for (int sig : { SIGSEGV, SIGABRT, SIGFPE, SIGILL }) std::signal(sig, SIG_DFL);
+        CloseCrashFile(s_crashFd);
+        s_crashFd = -1;
     }
 
     debugUI.Shutdown();
 }
 
 void App::Shutdown() {
-    g_platform.Shutdown();
+    // Whole-run frame-time summary (greppable for CI gates)
+    const DebugState& dbg = *m_dbg;
+    dbg.frameTimes.Print("frame");
+    dbg.updateTimes.Print("update");
+    dbg.renderTimes.Print("render");
+    dbg.presentTimes.Print("present");
+    Counters::Print();
+
+    if (m_cfg.tracePath) {
+        Profiler::WriteChromeTrace(m_cfg.tracePath, m_cfg.traceSeconds);
+    }
+    if (m_cfg.allocReportPath) {
+        AllocTracker::WriteReport(m_cfg.allocReportPath);
+    }
+
+    m_platform.Shutdown();
     std::printf("[INFO] Clean shutdown\n");
 }
@@ -1,18 +1,60 @@
 #pragma once
+#include "platform/SdlPlatform.h"
 #include <cstdint>
+#include <memory>
+
+struct DebugState;
 
 struct AppConfig {
     int windowWidth = 1280;
     int windowHeight = 720;
     const char* title = "Mini Engine";
+
+    // Fixed-step policy
+    float tickRate = 60.0f;         // simulation steps per second
+    int   maxSubsteps = 6;          // max catch-up steps per rendered frame
+    float maxFrameDt = 0.1f;        // platform dt clamp (debugger pauses etc.)
+    bool  degradeBeforeDrop = true; // throttle AI repaths before dropping sim time
+
+    // Internal render resolution: the scene is drawn at renderWidth x
+    // renderHeight and integer-upscaled to the window (nearest). 0 = native.
+    int renderWidth = 0;
+    int renderHeight = 0;
+    // Dynamic resolution: lower the rendered share of that resolution (in
+    // 1/8 steps) while the scene costs more than dynamicResTargetMs.
+    bool  dynamicResolution = false;
+    float dynamicResTargetMs = 8.0f;
+    float dynamicResMinScale = 0.5f;
+
+    // Diagnostics
+    const char* allocReportPath = nullptr;  // CSV written at shutdown (needs MINI_ENGINE_TRACK_ALLOCS)
+    const char* tracePath = nullptr;        // Chrome trace written at shutdown and on F9
+    float traceSeconds = 10.0f;             // how much history a trace dump covers
+
+    // Save states
+    const char* loadStatePath = nullptr;    // start from this checkpoint
+    const char* statePath = nullptr;        // final state at exit, last checkpoint on a crash
+    float checkpointSeconds = 1.0f;         // sim time between in-memory checkpoints
+
+    // Deterministic mode: the sim never depends on wall-clock cost (no AI
+    // throttling) and every step's state hash is computed (and logged).
+    bool deterministic = false;
+    const char* hashLogPath = nullptr;      // "tick hash" per line
 };
 
 class App {
 public:
+    App();
+    ~App();
+
     bool Init(const AppConfig& cfg);
     void Run();
     void Shutdown();
 
 private:
     bool m_running = false;
+    AppConfig m_cfg{};
+
+    SdlPlatform m_platform;
+    std::unique_ptr<DebugState> m_dbg;     // large (histories); kept off the stack
 };
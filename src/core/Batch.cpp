@@ -0,0 +1,221 @@
+#include "core/Batch.h"
+#include "engine/Log.h"
+#include "engine/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+    struct BatchTotals {
+        int failed = 0;
+        int64_t ticks = 0;
+        int wins = 0;
+        int losses = 0;
+        int64_t tokens = 0;
+        double tickMsSum = 0.0;     // sum of per-job averages
+        float tickMsMax = 0.0f;
+    };
+
+    BatchTotals Sum(const std::vector<ScenarioResult>& results) {
+        BatchTotals t;
+        for (const ScenarioResult& r : results) {
+            if (!r.ok) {
+                ++t.failed;
+                continue;
+            }
+            t.ticks += r.ticks;
+            t.wins += r.wins;
+            t.losses += r.losses;
+            t.tokens += r.tokensCollected;
+            t.tickMsSum += r.tick.avg;
+            t.tickMsMax = std::max(t.tickMsMax, r.tick.max);
+        }
+        return t;
+    }
+
+    // Names and paths only need quotes and backslashes escaped.
+    void WriteJsonString(FILE* f, const std::string& s) {
+        std::fputc('"', f);
+        for (char c : s) {
+            if (c == '"' || c == '\\') std::fputc('\\', f);
+            std::fputc(c, f);
+        }
+        std::fputc('"', f);
+    }
+
+    // RFC 4180: a field holding a comma, quote or newline is quoted, with
+    // quotes doubled. Anything else is written as is.
+    void WriteCsvField(FILE* f, const std::string& s) {
+        if (s.find_first_of(",\"\r\n") == std::string::npos) {
+            std::fputs(s.c_str(), f);
+            return;
+        }
+        std::fputc('"', f);
+        for (char c : s) {
+            if (c == '"') std::fputc('"', f);
+            std::fputc(c, f);
+        }
+        std::fputc('"', f);
+    }
+
+    const char* SourceName(const ScenarioSpec& spec) {
+        if (!spec.startStatePath.empty()) return spec.startStatePath.c_str();
+        if (!spec.mapPath.empty()) return spec.mapPath.c_str();
+        return MapGen::LayoutName(spec.gen.layout);
+    }
+
+    // Jobs run concurrently, so two of them writing one file would interleave.
+    bool CheckOutputPaths(const std::vector<ScenarioSpec>& jobs) {
+        std::unordered_set<std::string> seen;
+        bool ok = true;
+        for (const ScenarioSpec& s : jobs) {
+            for (const std::string* path : { &s.endStatePath, &s.hashLogPath }) {
+                if (path->empty() || seen.insert(*path).second) continue;
+                LOG_ERROR(LogCategory::Core, "Batch: job %s writes %s, which another job also writes",
+                    s.name.c_str(), path->c_str());
+                ok = false;
+            }
+        }
+        return ok;
+    }
+}
+
+namespace Batch {
+    void Expand(const std::vector<ScenarioSpec>& base, int count, std::vector<ScenarioSpec>& out) {
+        count = std::max(1, count);
+        out.reserve(out.size() + base.size() * (size_t)count);
+        for (const ScenarioSpec& spec : base) {
+            for (int i = 0; i < count; ++i) {
+                ScenarioSpec job = spec;
+                job.name = spec.name + "#" + std::to_string(i);
+                job.gen.seed = spec.gen.seed + (uint32_t)i;
+                job.inputSeed = spec.inputSeed + (uint32_t)i;
+                out.push_back(std::move(job));
+            }
+        }
+    }
+
+    int Run(const std::vector<ScenarioSpec>& jobs, const BatchOptions& options) {
+        if (!CheckOutputPaths(jobs)) return (int)jobs.size();
+
+        int threads = options.threads;
+        if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+        threads = std::max(1, std::min(threads, (int)jobs.size()));
+
+        // Zones from every worker would contend on the one shared ring.
+        const bool profilerWasEnabled = Profiler::Enabled();
+        Profiler::SetEnabled(false);
+
+        // Workers pull the next job index until the list is drained.
+        std::vector<ScenarioResult> results(jobs.size());
+        std::atomic<size_t> next{ 0 };
+        auto worker = [&]() {
+            for (size_t i = next.fetch_add(1); i < jobs.size(); i = next.fetch_add(1)) {
+                Scenario::Run(jobs[i], results[i]);
+            }
+        };
+
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point start = Clock::now();
+        std::vector<std::thread> pool;
+        pool.reserve((size_t)threads);
+        for (int t = 0; t < threads; ++t) pool.emplace_back(worker);
+        for (std::thread& t : pool) t.join();
+        const double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        Profiler::SetEnabled(profilerWasEnabled);
+
+        // Jobs that ran but missed a gate keep their stats in the totals and reports.
+        int gatesFailed = 0;
+        for (const ScenarioResult& r : results) {
+            if (r.ok && !Scenario::MeetsGates(r)) ++gatesFailed;
+        }
+
+        const BatchTotals totals = Sum(results);
+        const int ran = (int)jobs.size() - totals.failed;
+        std::printf("[BATCH] jobs=%d threads=%d failed=%d gates_failed=%d wall=%.2fs ticks=%lld ticks/s=%.0f"
+            " wins=%d losses=%d tokens=%lld tick avg=%.3f max=%.2f ms\n",
+            (int)jobs.size(), threads, totals.failed, gatesFailed, wallSeconds, (long long)totals.ticks,
+            wallSeconds > 0.0 ? (double)totals.ticks / wallSeconds : 0.0,
+            totals.wins, totals.losses, (long long)totals.tokens,
+            ran > 0 ? totals.tickMsSum / ran : 0.0, totals.tickMsMax);
+
+        if (!options.csvPath.empty() && !WriteCSV(options.csvPath.c_str(), jobs, results)) {
+            LOG_WARN(LogCategory::Core, "Could not write %s", options.csvPath.c_str());
+        }
+        if (!options.jsonPath.empty() && !WriteJSON(options.jsonPath.c_str(), jobs, results, threads, wallSeconds)) {
+            LOG_WARN(LogCategory::Core, "Could not write %s", options.jsonPath.c_str());
+        }
+        return totals.failed + gatesFailed;
+    }
+
+    bool WriteCSV(const char* path, const std::vector<ScenarioSpec>& jobs, const std::vector<ScenarioResult>& results) {
+        FILE* f = std::fopen(path, "w");
+        if (!f) return false;
+
+        std::fprintf(f, "name,source,map_seed,input_seed,config,ok,map_w,map_h,enemies,pickups,ticks,wall_s,"
+            "wins,losses,tokens,tick_avg_ms,tick_p50_ms,tick_p95_ms,tick_p99_ms,tick_max_ms,over_budget,"
+            "astar_calls,astar_expanded,pairs_tested,pairs_resolved,arena_peak,arena_overflows,"
+            "allocs_per_tick,alloc_peak,hash\n");
+        for (size_t i = 0; i < jobs.size() && i < results.size(); ++i) {
+            const ScenarioSpec& s = jobs[i];
+            const ScenarioResult& r = results[i];
+            WriteCsvField(f, s.name);
+            std::fputc(',', f);
+            WriteCsvField(f, SourceName(s));
+            std::fprintf(f, ",%u,%u,", s.gen.seed, s.inputSeed);
+            WriteCsvField(f, s.configPath);
+            std::fprintf(f, ",%d,%d,%d,%d,%d,%d,%.3f,%d,%d,%d,%.4f,%.3f,%.3f,%.3f,%.3f,%d,"
+                "%lld,%lld,%lld,%lld,%d,%d,%.2f,%lld,%016llx\n",
+                r.ok ? 1 : 0,
+                r.mapWidth, r.mapHeight, r.enemies, r.pickups, r.ticks, r.wallSeconds,
+                r.wins, r.losses, r.tokensCollected,
+                r.tick.avg, r.tick.p50, r.tick.p95, r.tick.p99, r.tick.max, r.tick.hitches,
+                (long long)r.astarCalls, (long long)r.astarExpanded,
+                (long long)r.pairsTested, (long long)r.pairsResolved,
+                r.arenaPeakBytes, r.arenaOverflows, r.allocsPerTick, (long long)r.allocPeakBytes,
+                (unsigned long long)r.runHash);
+        }
+        return std::fclose(f) == 0;
+    }
+
+    bool WriteJSON(const char* path, const std::vector<ScenarioSpec>& jobs, const std::vector<ScenarioResult>& results,
+        int threads, double wallSeconds) {
+        FILE* f = std::fopen(path, "w");
+        if (!f) return false;
+
+        const BatchTotals t = Sum(results);
+        std::fprintf(f, "{\"threads\":%d,\"wallSeconds\":%.3f,\"jobs\":%d,\"failed\":%d,\"ticks\":%lld,"
+            "\"wins\":%d,\"losses\":%d,\"tokens\":%lld,\"results\":[\n",
+            threads, wallSeconds, (int)jobs.size(), t.failed, (long long)t.ticks, t.wins, t.losses, (long long)t.tokens);
+
+        for (size_t i = 0; i < jobs.size() && i < results.size(); ++i) {
+            const ScenarioSpec& s = jobs[i];
+            const ScenarioResult& r = results[i];
+            std::fprintf(f, "%s{\"name\":", i > 0 ? ",\n" : "");
+            WriteJsonString(f, s.name);
+            std::fprintf(f, ",\"source\":");
+            WriteJsonString(f, SourceName(s));
+            std::fprintf(f, ",\"config\":");
+            WriteJsonString(f, s.configPath);
+            std::fprintf(f, ",\"mapSeed\":%u,\"inputSeed\":%u,\"ok\":%s,\"map\":[%d,%d],\"enemies\":%d,\"pickups\":%d,"
+                "\"ticks\":%d,\"wallSeconds\":%.3f,\"wins\":%d,\"losses\":%d,\"tokens\":%d,"
+                "\"tickMs\":{\"avg\":%.4f,\"p50\":%.3f,\"p95\":%.3f,\"p99\":%.3f,\"max\":%.3f,\"overBudget\":%d},"
+                "\"astarCalls\":%lld,\"astarExpanded\":%lld,\"pairsTested\":%lld,\"pairsResolved\":%lld,"
+                "\"arenaPeak\":%d,\"arenaOverflows\":%d,\"allocsPerTick\":%.2f,\"allocPeak\":%lld,"
+                "\"hash\":\"%016llx\"}",
+                s.gen.seed, s.inputSeed, r.ok ? "true" : "false", r.mapWidth, r.mapHeight, r.enemies, r.pickups,
+                r.ticks, r.wallSeconds, r.wins, r.losses, r.tokensCollected,
+                r.tick.avg, r.tick.p50, r.tick.p95, r.tick.p99, r.tick.max, r.tick.hitches,
+                (long long)r.astarCalls, (long long)r.astarExpanded,
+                (long long)r.pairsTested, (long long)r.pairsResolved,
+                r.arenaPeakBytes, r.arenaOverflows, r.allocsPerTick, (long long)r.allocPeakBytes,
+                (unsigned long long)r.runHash);
+        }
+        std::fprintf(f, "\n]}\n");
+        return std::fclose(f) == 0;
+    }
+}
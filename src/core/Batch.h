@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "core/Scenario.h"
+
+/**
+ * Many independent headless runs (balance tuning: levels x configs x input
+ * seeds) spread over a pool of worker threads. Each job is a full
+ * Scenario::Run with its own Game, platform, frame arena and counters, so
+ * throughput scales with cores; results come back in job order.
+ */
+struct BatchOptions {
+    int threads = 0;            // 0 = one per hardware thread
+    std::string csvPath;        // one row per job
+    std::string jsonPath;       // per-job results plus totals
+};
+
+namespace Batch {
+    // `count` jobs per base spec: generated maps get seed gen.seed + i and
+    // every job gets inputSeed + i. Names become "<name>#<i>". Output paths are
+    // copied as-is, so derive them from the job names after expanding.
+    void Expand(const std::vector<ScenarioSpec>& base, int count, std::vector<ScenarioSpec>& out);
+
+    // Runs every job, prints a [BATCH] summary and writes the reports.
+    // Returns how many jobs failed to start or missed Scenario::MeetsGates;
+    // all of them if two jobs share an end-state or hash-log path, in which
+    // case nothing runs.
+    int Run(const std::vector<ScenarioSpec>& jobs, const BatchOptions& options);
+
+    bool WriteCSV(const char* path, const std::vector<ScenarioSpec>& jobs, const std::vector<ScenarioResult>& results);
+    bool WriteJSON(const char* path, const std::vector<ScenarioSpec>& jobs, const std::vector<ScenarioResult>& results,
+        int threads, double wallSeconds);
+}
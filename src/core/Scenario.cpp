@@ -0,0 +1,283 @@
+#include "core/Scenario.h"
+#include "game/Game.h"
+#include "game/Tilemap.h"
+#include "platform/SdlPlatform.h"
+#include "engine/DebugState.h"
+#include "engine/Counters.h"
+#include "engine/Random.h"
+#include "engine/BinaryStream.h"
+#include "engine/Hash.h"
+#include "engine/Log.h"
+#include "engine/AllocTracker.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+namespace {
+    constexpr float kFixedDt = 1.0f / 60.0f;
+    constexpr int kViewW = 1280;        // AI LOD and camera use the view size
+    constexpr int kViewH = 720;
+    constexpr int kInputHoldTicks = 60; // scripted input changes once a second
+    constexpr int kCheckpointTicks = 60;
+
+    // Counter totals sampled before/after a run.
+    struct CounterSample {
+        int64_t astarCalls = 0;
+        int64_t astarExpanded = 0;
+        int64_t pairsTested = 0;
+        int64_t pairsResolved = 0;
+        int64_t tileTests = 0;
+        int64_t tileResolves = 0;
+    };
+
+    CounterSample SampleCounters(const CounterScope& counters) {
+        CounterSample s;
+        s.astarCalls = counters.Total("astar.calls");
+        s.astarExpanded = counters.Total("astar.expanded");
+        s.pairsTested = counters.Total("collision.pairsTested");
+        s.pairsResolved = counters.Total("collision.pairsResolved");
+        s.tileTests = counters.Total("collision.tileTests");
+        s.tileResolves = counters.Total("collision.tileResolves");
+        return s;
+    }
+
+    // Wander: one of 8 directions (or standing still) per hold period.
+    void ScriptedInput(Rng& rng, int tick, int& dir, Input& input) {
+        if (tick % kInputHoldTicks == 0) dir = rng.Range(9);
+
+        static const bool kKeys[9][4] = {   // W A S D
+            { 1, 0, 0, 0 }, { 1, 0, 0, 1 }, { 0, 0, 0, 1 }, { 0, 0, 1, 1 },
+            { 0, 0, 1, 0 }, { 0, 1, 1, 0 }, { 0, 1, 0, 0 }, { 1, 1, 0, 0 },
+            { 0, 0, 0, 0 },
+        };
+        input.SetKey(Key::W, kKeys[dir][0]);
+        input.SetKey(Key::A, kKeys[dir][1]);
+        input.SetKey(Key::S, kKeys[dir][2]);
+        input.SetKey(Key::D, kKeys[dir][3]);
+    }
+
+    void CountMarkers(const Tilemap& map, ScenarioResult& out) {
+        for (int y = 0; y < map.Height(); ++y) {
+            for (int x = 0; x < map.Width(); ++x) {
+                const int t = map.At(x, y);
+                if (t == TileId::Chaser || t == TileId::Fast || t == TileId::Tank) out.enemies++;
+                else if (t == TileId::Token || t == TileId::Health || t == TileId::Speed || t == TileId::Shield) out.pickups++;
+            }
+        }
+    }
+
+    ScenarioSpec Generated(const char* name, MapLayout layout, int w, int h, float enemyDensity, int ticks) {
+        ScenarioSpec s;
+        s.name = name;
+        s.gen.layout = layout;
+        s.gen.width = w;
+        s.gen.height = h;
+        s.gen.seed = 1337;
+        s.gen.enemyDensity = enemyDensity;
+        s.ticks = ticks;
+        return s;
+    }
+}
+
+namespace Scenario {
+    void StandardCorpus(std::vector<ScenarioSpec>& out) {
+        out.push_back(Generated("maze-63", MapLayout::Maze, 63, 63, 0.02f, 1800));
+        out.push_back(Generated("maze-255", MapLayout::Maze, 255, 255, 0.01f, 1800));
+        out.push_back(Generated("cave-128", MapLayout::Cave, 128, 128, 0.02f, 1800));
+        out.push_back(Generated("cave-256", MapLayout::Cave, 256, 256, 0.01f, 1800));
+        out.push_back(Generated("arena-64", MapLayout::Arena, 64, 64, 0.05f, 1800));
+        out.push_back(Generated("arena-160", MapLayout::Arena, 160, 160, 0.02f, 900));
+    }
+
+    bool Run(const ScenarioSpec& spec, ScenarioResult& out) {
+        out = ScenarioResult{};
+        out.name = spec.name;
+
+        // This thread's counts only (other runs may be going concurrently)
+        CounterScope counters;
+
+        // A forked run takes its map from the saved state instead.
+        Tilemap map;
+        const bool forked = !spec.startStatePath.empty();
+        if (!forked && !spec.mapPath.empty()) {
+            if (!map.LoadCSV(spec.mapPath.c_str())) {
+                LOG_ERROR(LogCategory::Core, "Scenario %s: could not load %s", spec.name.c_str(), spec.mapPath.c_str());
+                return false;
+            }
+        }
+        else if (!forked && !MapGen::Generate(spec.gen, map)) {
+            LOG_ERROR(LogCategory::Core, "Scenario %s: map generation failed", spec.name.c_str());
+            return false;
+        }
+        SdlPlatform platform;
+        if (!platform.InitHeadless(kViewW, kViewH)) return false;
+
+        // Both are large (snapshots, histories); keep them off the stack.
+        auto game = std::make_unique<Game>();
+        auto dbg = std::make_unique<DebugState>();
+        dbg->tickRate = 1.0f / kFixedDt;
+        dbg->updateBudgetMs = kFixedDt * 1000.0f;
+        dbg->updateTimes.SetBudget(dbg->updateBudgetMs);
+
+        if (!game->Init(platform)) {
+            platform.Shutdown();
+            return false;
+        }
+        if (!spec.configPath.empty() && !game->ReloadConfig(spec.configPath.c_str())) {
+            LOG_ERROR(LogCategory::Config, "Scenario %s: could not load config %s", spec.name.c_str(), spec.configPath.c_str());
+            game.reset();
+            platform.Shutdown();
+            return false;
+        }
+        if (forked) {
+            std::vector<uint8_t> state;
+            if (!ReadBinaryFile(spec.startStatePath.c_str(), state) || !game->LoadState(state)) {
+                LOG_ERROR(LogCategory::Core, "Scenario %s: could not load state %s", spec.name.c_str(), spec.startStatePath.c_str());
+                game.reset();
+                platform.Shutdown();
+                return false;
+            }
+        }
+        else {
+            game->LoadMap(map);
+        }
+        out.mapWidth = game->Map().Width();
+        out.mapHeight = game->Map().Height();
+        CountMarkers(game->Map(), out);
+
+        counters.EndFrame();    // close anything counted during setup
+        const CounterSample before = SampleCounters(counters);
+        const bool trackAllocs = AllocTracker::Enabled();
+        AllocStats allocs;
+        AllocTracker::GetStats(allocs);
+        const uint64_t allocsBefore = allocs.total.allocs;
+
+        using Clock = std::chrono::steady_clock;
+        Rng rng(spec.inputSeed);
+        int dir = 8;
+        std::vector<uint8_t> checkpoint;
+        double saveMsTotal = 0.0;
+        int saves = 0;
+
+        const bool hashing = spec.hashState || !spec.hashLogPath.empty();
+        FILE* hashLog = spec.hashLogPath.empty() ? nullptr : std::fopen(spec.hashLogPath.c_str(), "w");
+        uint64_t runHash = kHashSeed;
+        const Clock::time_point runStart = Clock::now();
+
+        for (int tick = 0; tick < spec.ticks; ++tick) {
+            if (!game->IsPlaying()) {
+                if (game->IsWon()) out.wins++;
+                else out.losses++;
+                out.tokensCollected += game->TokensCollected();
+                game->Restart();
+            }
+
+            Input input;
+            ScriptedInput(rng, tick, dir, input);
+
+            const Clock::time_point t0 = Clock::now();
+            game->Update(platform, input, kFixedDt, *dbg);
+            dbg->updateTimes.Push(std::chrono::duration<float, std::milli>(Clock::now() - t0).count());
+
+            out.arenaPeakBytes = std::max(out.arenaPeakBytes, dbg->arenaHighWaterBytes);
+            counters.EndFrame();
+            if (trackAllocs) {
+                AllocTracker::GetStats(allocs);
+                out.allocPeakBytes = std::max(out.allocPeakBytes, allocs.total.liveBytes);
+            }
+
+            if (hashing) {
+                const uint64_t h = game->ComputeStateHash();
+                runHash = HashBytes(&h, sizeof(h), runHash);
+                if (hashLog) std::fprintf(hashLog, "%d %016llx\n", tick + 1, (unsigned long long)h);
+            }
+
+            if ((tick + 1) % kCheckpointTicks == 0) {
+                const Clock::time_point s0 = Clock::now();
+                game->SaveState(checkpoint);
+                const float saveMs = std::chrono::duration<float, std::milli>(Clock::now() - s0).count();
+                saveMsTotal += saveMs;
+                out.stateSaveMsMax = std::max(out.stateSaveMsMax, saveMs);
+                ++saves;
+            }
+        }
+
+        out.wallSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+        out.ticks = spec.ticks;
+        out.tick = dbg->updateTimes.SummarizeLifetime();
+        out.arenaOverflows = dbg->arenaOverflows;
+        if (trackAllocs && spec.ticks > 0) {
+            AllocTracker::GetStats(allocs);
+            out.allocsPerTick = (float)((double)(allocs.total.allocs - allocsBefore) / spec.ticks);
+        }
+
+        const CounterSample after = SampleCounters(counters);
+        out.tokensCollected += game->TokensCollected();
+        out.astarCalls = after.astarCalls - before.astarCalls;
+        out.astarExpanded = after.astarExpanded - before.astarExpanded;
+        out.pairsTested = after.pairsTested - before.pairsTested;
+        out.pairsResolved = after.pairsResolved - before.pairsResolved;
+        out.tileTests = after.tileTests - before.tileTests;
+        out.tileResolves = after.tileResolves - before.tileResolves;
+
+        if (hashLog) std::fclose(hashLog);
+        if (hashing) out.runHash = runHash;
+        if (saves > 0) out.stateSaveMsAvg = (float)(saveMsTotal / saves);
+        game->SaveState(checkpoint);
+        out.stateBytes = (int)checkpoint.size();
+        if (!spec.endStatePath.empty() && !WriteBinaryFile(spec.endStatePath.c_str(), checkpoint)) {
+            LOG_WARN(LogCategory::Core, "Scenario %s: could not write state %s", spec.name.c_str(), spec.endStatePath.c_str());
+        }
+
+        game.reset();
+        platform.Shutdown();
+        out.ok = true;
+        return true;
+    }
+
+    bool MeetsGates(const ScenarioResult& r) {
+        if (!r.ok) return false;
+        // Overflowing the frame arena means per-tick heap traffic.
+        if (r.arenaOverflows > 0) {
+            LOG_ERROR(LogCategory::Core, "Scenario %s: frame arena overflowed %d time(s) (peak %d bytes)",
+                r.name.c_str(), r.arenaOverflows, r.arenaPeakBytes);
+            return false;
+        }
+        return true;
+    }
+
+    void Print(const ScenarioResult& r) {
+        if (!r.ok) {
+            std::printf("[SCENARIO] %-10s FAILED\n", r.name.c_str());
+            return;
+        }
+        std::printf("[SCENARIO] %-10s map=%dx%d enemies=%d pickups=%d ticks=%d wall=%.2fs"
+            " tick avg=%.3f p50=%.1f p95=%.1f p99=%.1f max=%.2f ms over=%d"
+            " astar.calls=%lld astar.expanded=%lld pairs.tested=%lld pairs.resolved=%lld"
+            " tiles.tested=%lld tiles.resolved=%lld arena.peak=%d arena.overflows=%d"
+            " allocs/tick=%.2f alloc.peak=%lld"
+            " wins=%d losses=%d tokens=%d"
+            " state=%dB save avg=%.3f max=%.3f ms hash=%016llx\n",
+            r.name.c_str(), r.mapWidth, r.mapHeight, r.enemies, r.pickups, r.ticks, r.wallSeconds,
+            r.tick.avg, r.tick.p50, r.tick.p95, r.tick.p99, r.tick.max, r.tick.hitches,
+            (long long)r.astarCalls, (long long)r.astarExpanded,
+            (long long)r.pairsTested, (long long)r.pairsResolved,
+            (long long)r.tileTests, (long long)r.tileResolves,
+            r.arenaPeakBytes, r.arenaOverflows,
+            r.allocsPerTick, (long long)r.allocPeakBytes,
+            r.wins, r.losses, r.tokensCollected,
+            r.stateBytes, r.stateSaveMsAvg, r.stateSaveMsMax, (unsigned long long)r.runHash);
+    }
+
+    int RunAll(const std::vector<ScenarioSpec>& specs) {
+        int failed = 0;
+        for (const ScenarioSpec& spec : specs) {
+            ScenarioResult result;
+            Run(spec, result);
+            Print(result);
+            if (!MeetsGates(result)) ++failed;
+        }
+        return failed;
+    }
+}
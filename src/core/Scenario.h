@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "engine/FrameStats.h"
+#include "game/MapGen.h"
+
+/**
+ * One headless stress run: a level (CSV or generated), a tick count and a
+ * seed for the scripted player input.
+ */
+struct ScenarioSpec {
+    std::string name;
+    std::string mapPath;        // CSV level; empty = generate from `gen`
+    MapGenParams gen;
+    int ticks = 1800;           // 30 s at 60 Hz
+    uint32_t inputSeed = 1;
+    std::string configPath;     // applied over assets/config.json (tuning variants)
+
+    std::string startStatePath; // fork from a saved state (its map wins over mapPath/gen)
+    std::string endStatePath;   // save the final state here
+
+    // Deterministic check: hash the state after every tick (untimed).
+    bool hashState = false;
+    std::string hashLogPath;    // per-tick "tick hash" lines, to find the first divergence
+};
+
+struct ScenarioResult {
+    std::string name;
+    bool ok = false;
+
+    int mapWidth = 0;
+    int mapHeight = 0;
+    int enemies = 0;            // spawn markers in the map
+    int pickups = 0;
+
+    int ticks = 0;
+    double wallSeconds = 0.0;
+    FrameTimeSummary tick;      // Game::Update cost (ms)
+
+    // Counter deltas over the run
+    int64_t astarCalls = 0;
+    int64_t astarExpanded = 0;
+    int64_t pairsTested = 0;
+    int64_t pairsResolved = 0;
+    int64_t tileTests = 0;
+    int64_t tileResolves = 0;
+
+    int arenaPeakBytes = 0;
+    int arenaOverflows = 0;
+
+    // Heap traffic (MINI_ENGINE_TRACK_ALLOCS builds only, else 0). The tracker
+    // is process-wide, so concurrent batch jobs see each other's allocations.
+    float allocsPerTick = 0.0f;
+    int64_t allocPeakBytes = 0;     // live heap, sampled after every tick
+    // Outcome: every win/lose screen restarts the level
+    int wins = 0;
+    int losses = 0;
+    int tokensCollected = 0;    // summed over all attempts
+
+    // Once-per-second checkpoint cost (Game::SaveState)
+    int stateBytes = 0;
+    float stateSaveMsAvg = 0.0f;
+    float stateSaveMsMax = 0.0f;
+
+    uint64_t runHash = 0;       // chain of every tick's state hash (hashState only)
+};
+
+/**
+ * Headless scenario runner: runs Game::Update without a window as fast as
+ * possible and reports tick-time, pathfinding and collision stats.
+ *
+ * Run() owns everything it touches (platform, game, debug state, counters),
+ * so any number of runs may execute concurrently on different threads.
+ */
+namespace Scenario {
+    // Standard stress corpus: mazes, caves and arenas from small to large.
+    void StandardCorpus(std::vector<ScenarioSpec>& out);
+
+    // False if the run could not start (map, config or state failed to load).
+    bool Run(const ScenarioSpec& spec, ScenarioResult& out);
+
+    // CI pass/fail over a finished run: it started and never overflowed the
+    // frame arena. Logs why when it fails.
+    bool MeetsGates(const ScenarioResult& result);
+
+    // One greppable [SCENARIO] line.
+    void Print(const ScenarioResult& result);
+
+    // Runs and prints every spec; returns how many failed MeetsGates.
+    int RunAll(const std::vector<ScenarioSpec>& specs);
+}
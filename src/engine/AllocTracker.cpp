@@ -0,0 +1,196 @@
+#include "engine/AllocTracker.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static const char* kTagNames[(int)AllocTag::Count] = {
+    "untagged", "entities", "pathfinding", "config", "assets", "imgui"
+};
+
+const char* AllocTagName(AllocTag tag) {
+    const int i = (int)tag;
+    return (i >= 0 && i < (int)AllocTag::Count) ? kTagNames[i] : "?";
+}
+
+#if defined(MINI_ENGINE_TRACK_ALLOCS) && MINI_ENGINE_TRACK_ALLOCS
+
+namespace {
+    struct TagCounters {
+        std::atomic<int64_t> liveBytes{ 0 };
+        std::atomic<int64_t> peakBytes{ 0 };
+        std::atomic<uint64_t> allocs{ 0 };
+        std::atomic<uint64_t> frees{ 0 };
+
+        // Main thread only (EndFrame / GetStats)
+        uint64_t frameStartAllocs = 0;
+        uint64_t lastFrameAllocs = 0;
+        uint64_t maxFrameAllocs = 0;
+    };
+
+    // Constant-initialized, so usable by allocations made before main().
+    TagCounters g_tags[(int)AllocTag::Count];
+    TagCounters g_total;
+    uint64_t g_frames = 0;
+
+    thread_local AllocTag t_tag = AllocTag::Untagged;
+
+    // Sits directly in front of every tracked block.
+    struct alignas(16) AllocHeader {
+        uint64_t size;
+        uint32_t offset;    // user pointer - malloc pointer
+        uint8_t tag;
+    };
+    static_assert(sizeof(AllocHeader) == 16, "header must keep 16-byte alignment");
+
+    void RaisePeak(std::atomic<int64_t>& peak, int64_t live) {
+        int64_t cur = peak.load(std::memory_order_relaxed);
+        while (live > cur && !peak.compare_exchange_weak(cur, live, std::memory_order_relaxed)) {}
+    }
+
+    void Count(TagCounters& c, int64_t bytes) {
+        if (bytes > 0) {
+            c.allocs.fetch_add(1, std::memory_order_relaxed);
+            RaisePeak(c.peakBytes, c.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+        }
+        else {
+            c.frees.fetch_add(1, std::memory_order_relaxed);
+            c.liveBytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    void* TrackedAlloc(size_t size, size_t align) {
+        if (align < alignof(AllocHeader)) align = alignof(AllocHeader);
+        const size_t slack = sizeof(AllocHeader) + (align > alignof(AllocHeader) ? align : 0);
+
+        void* raw = std::malloc(size + slack);
+        if (!raw) return nullptr;
+
+        const uintptr_t base = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t user = (base + sizeof(AllocHeader) + (align - 1)) & ~(uintptr_t)(align - 1);
+
+        AllocHeader* h = reinterpret_cast<AllocHeader*>(user) - 1;
+        h->size = size;
+        h->offset = (uint32_t)(user - base);
+        h->tag = (uint8_t)t_tag;
+
+        Count(g_tags[h->tag], (int64_t)size);
+        Count(g_total, (int64_t)size);
+        return reinterpret_cast<void*>(user);
+    }
+
+    void TrackedFree(void* p) {
+        if (!p) return;
+        AllocHeader* h = static_cast<AllocHeader*>(p) - 1;
+        Count(g_tags[h->tag], -(int64_t)h->size);
+        Count(g_total, -(int64_t)h->size);
+        std::free(static_cast<unsigned char*>(p) - h->offset);
+    }
+
+    void* TrackedAllocOrThrow(size_t size, size_t align) {
+        void* p = TrackedAlloc(size, align);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+    void FillStats(const TagCounters& c, AllocTagStats& out) {
+        out.liveBytes = c.liveBytes.load(std::memory_order_relaxed);
+        out.peakBytes = c.peakBytes.load(std::memory_order_relaxed);
+        out.allocs = c.allocs.load(std::memory_order_relaxed);
+        out.frees = c.frees.load(std::memory_order_relaxed);
+        out.frameAllocs = c.lastFrameAllocs;
+        out.maxFrameAllocs = c.maxFrameAllocs;
+    }
+
+    void CloseFrame(TagCounters& c) {
+        const uint64_t allocs = c.allocs.load(std::memory_order_relaxed);
+        c.lastFrameAllocs = allocs - c.frameStartAllocs;
+        c.frameStartAllocs = allocs;
+        if (c.lastFrameAllocs > c.maxFrameAllocs) c.maxFrameAllocs = c.lastFrameAllocs;
+    }
+}
+
+AllocScope::AllocScope(AllocTag tag) : m_prev(t_tag) { t_tag = tag; }
+AllocScope::~AllocScope() { t_tag = m_prev; }
+
+// ---- Global operator new/delete replacements ----
+static constexpr size_t kDefaultAlign = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+void* operator new(size_t size) { return TrackedAllocOrThrow(size, kDefaultAlign); }
+void* operator new[](size_t size) { return TrackedAllocOrThrow(size, kDefaultAlign); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size, kDefaultAlign); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size, kDefaultAlign); }
+void* operator new(size_t size, std::align_val_t al) { return TrackedAllocOrThrow(size, (size_t)al); }
+void* operator new[](size_t size, std::align_val_t al) { return TrackedAllocOrThrow(size, (size_t)al); }
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return TrackedAlloc(size, (size_t)al); }
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return TrackedAlloc(size, (size_t)al); }
+
+void operator delete(void* p) noexcept { TrackedFree(p); }
+void operator delete[](void* p) noexcept { TrackedFree(p); }
+void operator delete(void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(p); }
+
+namespace AllocTracker {
+    bool Enabled() { return true; }
+
+    void EndFrame() {
+        for (TagCounters& c : g_tags) CloseFrame(c);
+        CloseFrame(g_total);
+        g_frames++;
+    }
+
+    void GetStats(AllocStats& out) {
+        for (int i = 0; i < (int)AllocTag::Count; ++i) FillStats(g_tags[i], out.tags[i]);
+        FillStats(g_total, out.total);
+        out.frames = g_frames;
+    }
+}
+
+#else
+
+namespace AllocTracker {
+    bool Enabled() { return false; }
+    void EndFrame() {}
+    void GetStats(AllocStats& out) { out = AllocStats{}; }
+}
+
+#endif
+
+bool AllocTracker::WriteReport(const char* path) {
+    if (!Enabled()) {
+        std::printf("[WARN] Alloc report requested but tracking is off (MINI_ENGINE_TRACK_ALLOCS)\n");
+        return false;
+    }
+
+    AllocStats stats;
+    GetStats(stats);
+
+    FILE* f = std::fopen(path, "w");
+    if (!f) {
+        std::printf("[ERROR] Could not write alloc report: %s\n", path);
+        return false;
+    }
+
+    std::fprintf(f, "tag,live_bytes,peak_bytes,allocs,frees,last_frame_allocs,max_frame_allocs\n");
+    auto row = [f](const char* name, const AllocTagStats& s) {
+        std::fprintf(f, "%s,%lld,%lld,%llu,%llu,%llu,%llu\n", name,
+            (long long)s.liveBytes, (long long)s.peakBytes,
+            (unsigned long long)s.allocs, (unsigned long long)s.frees,
+            (unsigned long long)s.frameAllocs, (unsigned long long)s.maxFrameAllocs);
+    };
+    for (int i = 0; i < (int)AllocTag::Count; ++i) row(AllocTagName((AllocTag)i), stats.tags[i]);
+    row("total", stats.total);
+    std::fclose(f);
+
+    std::printf("[INFO] Alloc report written (%llu frames): %s\n", (unsigned long long)stats.frames, path);
+    return true;
+}
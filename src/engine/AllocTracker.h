@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Opt-in heap tracking.
+ *
+ * Configure with -DMINI_ENGINE_TRACK_ALLOCS=ON to replace the global
+ * operator new/delete. Every allocation is then tagged with the subsystem
+ * active on the calling thread (see AllocScope). Without the option the
+ * hooks are not compiled, AllocScope is empty and Enabled() is false.
+ */
+enum class AllocTag : uint8_t {
+    Untagged,
+    Entities,
+    Pathfinding,
+    Config,
+    Assets,
+    ImGui,
+    Count
+};
+
+const char* AllocTagName(AllocTag tag);
+
+struct AllocTagStats {
+    int64_t liveBytes = 0;
+    int64_t peakBytes = 0;
+    uint64_t allocs = 0;        // lifetime totals
+    uint64_t frees = 0;
+    uint64_t frameAllocs = 0;   // during the last completed frame
+    uint64_t maxFrameAllocs = 0;
+};
+
+struct AllocStats {
+    AllocTagStats tags[(int)AllocTag::Count];
+    AllocTagStats total;
+    uint64_t frames = 0;
+};
+
+#if defined(MINI_ENGINE_TRACK_ALLOCS) && MINI_ENGINE_TRACK_ALLOCS
+
+// Tags allocations made on this thread until it goes out of scope (nests).
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag tag);
+    ~AllocScope();
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+    AllocTag m_prev;
+};
+
+#else
+
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag) {}
+};
+
+#endif
+
+namespace AllocTracker {
+    bool Enabled();
+
+    // Call once per frame: closes the per-frame counters.
+    void EndFrame();
+
+    void GetStats(AllocStats& out);
+
+    // CSV: one row per tag plus a total row. Returns false if tracking is off
+    // or the file can't be written.
+    bool WriteReport(const char* path);
+}
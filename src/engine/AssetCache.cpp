@@ -0,0 +1,284 @@
+#include "engine/AssetCache.h"
+#include "platform/SdlPlatform.h"
+#include "engine/AllocTracker.h"
+#include "engine/Log.h"
+
+#include <SDL.h>
+#include <algorithm>
+
+bool AssetCache::Init(SdlPlatform& platform) {
+    if (m_worker.joinable()) return true;
+
+    m_platform = &platform;
+    m_quit = false;
+    m_worker = std::thread(&AssetCache::WorkerMain, this);
+    return true;
+}
+
+void AssetCache::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+        m_jobs.clear();
+    }
+    m_cv.notify_all();
+    if (m_worker.joinable()) m_worker.join();
+
+    for (Decoded& d : m_decoded) {
+        if (d.surface) SDL_FreeSurface(d.surface);
+    }
+    m_decoded.clear();
+    m_completed.clear();
+    m_inFlight = 0;
+
+    for (Entry& e : m_entries) {
+        e.texture.Destroy();
+        if (e.image) SDL_FreeSurface(e.image);
+    }
+    m_entries.clear();
+    m_freeSlots.clear();
+    m_byHash.clear();
+}
+
+uint64_t AssetCache::HashPath(const std::string& path) {
+    // FNV-1a 64
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : path) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+TextureHandle AssetCache::AcquireTexture(const std::string& path) {
+    return Acquire(path, true);
+}
+
+TextureHandle AssetCache::AcquireImage(const std::string& path) {
+    return Acquire(path, false);
+}
+
+TextureHandle AssetCache::Acquire(const std::string& path, bool texture) {
+    const uint64_t hash = HashPath(path);
+
+    auto it = m_byHash.find(hash);
+    if (it != m_byHash.end()) {
+        Entry& e = m_entries[it->second];
+        e.refs++;
+        if (texture && !e.wantsTexture) {
+            // Already decoded as an image: upload that now rather than re-read.
+            e.wantsTexture = true;
+            if (e.image) e.texture.CreateFromSurface(*m_platform, e.image);
+        }
+        else if (!texture && !e.keepImage) {
+            // Texture-only entries drop their pixels after upload; decode again.
+            e.keepImage = true;
+            if (e.pending == 0) Enqueue(it->second);
+        }
+        return TextureHandle{ ((uint32_t)e.generation << 16) | (it->second + 1) };
+    }
+
+    uint32_t slot = 0;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        slot = (uint32_t)m_entries.size();
+        m_entries.emplace_back();
+    }
+
+    Entry& e = m_entries[slot];
+    e.path = path;
+    e.hash = hash;
+    e.refs = 1;
+    e.pending = 0;
+    e.state = State::Loading;
+    e.wantsTexture = texture;
+    e.keepImage = !texture;
+    m_byHash[hash] = slot;
+
+    Enqueue(slot);
+    return TextureHandle{ ((uint32_t)e.generation << 16) | (slot + 1) };
+}
+
+void AssetCache::Release(TextureHandle h) {
+    Entry* e = Resolve(h);
+    if (!e || --e->refs > 0) return;
+
+    const uint32_t slot = (h.id & 0xFFFFu) - 1;
+    e->texture.Destroy();
+    if (e->image) SDL_FreeSurface(e->image);
+    e->image = nullptr;
+    e->pending = 0;
+    e->state = State::Free;
+    e->path.clear();
+    m_byHash.erase(e->hash);
+
+    // New generation: in-flight decodes and stale handles for this slot are ignored.
+    e->generation = (uint16_t)(e->generation + 1);
+    if (e->generation == 0) e->generation = 1;
+    m_freeSlots.push_back(slot);
+}
+
+void AssetCache::Reload(TextureHandle h) {
+    Entry* e = Resolve(h);
+    if (!e) return;
+    if (e->state == State::Failed) e->state = State::Loading;
+    Enqueue((h.id & 0xFFFFu) - 1);
+}
+
+void AssetCache::Enqueue(uint32_t slot) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Job job;
+        job.slot = slot;
+        job.generation = m_entries[slot].generation;
+        job.path = m_entries[slot].path;
+        m_jobs.push_back(std::move(job));
+        m_inFlight++;
+    }
+    m_entries[slot].pending++;
+    m_cv.notify_one();
+}
+
+void AssetCache::RunAsync(std::function<void()> work, std::function<void()> done) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Job job;
+        job.work = std::move(work);
+        job.done = std::move(done);
+        m_jobs.push_back(std::move(job));
+        m_inFlight++;
+    }
+    m_cv.notify_one();
+}
+
+void AssetCache::PumpUploads(int maxUploads) {
+    std::vector<Decoded> ready;
+    std::vector<std::function<void()>> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_decoded.empty() && m_completed.empty()) return;
+
+        completed.swap(m_completed);
+
+        const size_t n = std::min(m_decoded.size(), (size_t)std::max(1, maxUploads));
+        ready.assign(m_decoded.begin(), m_decoded.begin() + (ptrdiff_t)n);
+        m_decoded.erase(m_decoded.begin(), m_decoded.begin() + (ptrdiff_t)n);
+    }
+
+    for (const Decoded& d : ready) {
+        const bool live = d.slot < m_entries.size() &&
+            m_entries[d.slot].generation == d.generation &&
+            m_entries[d.slot].state != State::Free;
+
+        SDL_Surface* surface = d.surface;
+        if (live) {
+            Entry& e = m_entries[d.slot];
+            e.pending--;
+            bool ok = surface != nullptr;
+            if (ok && e.wantsTexture) ok = e.texture.CreateFromSurface(*m_platform, surface);
+            if (ok) {
+                if (e.keepImage) {
+                    if (e.image) SDL_FreeSurface(e.image);
+                    e.image = surface;
+                    surface = nullptr;
+                }
+                e.state = State::Ready;
+                LOG_INFO(LogCategory::Assets, "Loaded %s: %s (%dx%d)", e.wantsTexture ? "texture" : "image",
+                    e.path.c_str(), d.surface->w, d.surface->h);
+            }
+            else if (e.state != State::Ready) {
+                // Keep the previous texture/image on a failed reload; only fail fresh loads.
+                e.state = State::Failed;
+            }
+        }
+        if (surface) SDL_FreeSurface(surface);
+    }
+
+    for (auto& done : completed) {
+        if (done) done();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_inFlight -= (int)(ready.size() + completed.size());
+}
+
+void AssetCache::WaitIdle() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_inFlight <= 0) return;
+        }
+        PumpUploads(64);
+        std::this_thread::yield();
+    }
+}
+
+const SdlTexture* AssetCache::Get(TextureHandle h) const {
+    const Entry* e = Resolve(h);
+    if (!e || !e->texture.Raw()) return nullptr;
+    return &e->texture;
+}
+
+SDL_Surface* AssetCache::GetImage(TextureHandle h) const {
+    const Entry* e = Resolve(h);
+    return e ? e->image : nullptr;
+}
+
+bool AssetCache::Failed(TextureHandle h) const {
+    const Entry* e = Resolve(h);
+    return !e || e->state == State::Failed;
+}
+
+bool AssetCache::Pending(TextureHandle h) const {
+    const Entry* e = Resolve(h);
+    return e && e->pending > 0;
+}
+
+AssetCache::Entry* AssetCache::Resolve(TextureHandle h) {
+    if (!h.Valid()) return nullptr;
+    const uint32_t slot = (h.id & 0xFFFFu) - 1;
+    const uint16_t gen = (uint16_t)(h.id >> 16);
+    if (slot >= m_entries.size()) return nullptr;
+
+    Entry& e = m_entries[slot];
+    if (e.state == State::Free || e.generation != gen) return nullptr;
+    return &e;
+}
+
+const AssetCache::Entry* AssetCache::Resolve(TextureHandle h) const {
+    return const_cast<AssetCache*>(this)->Resolve(h);
+}
+
+void AssetCache::WorkerMain() {
+    AllocScope allocScope(AllocTag::Assets);   // everything on this thread
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_quit || !m_jobs.empty(); });
+            if (m_quit) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        if (job.work) {
+            job.work();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_completed.push_back(std::move(job.done));
+            continue;
+        }
+
+        // Disk read + decode happen here, off the render thread.
+        SDL_Surface* surf = SDL_LoadBMP(job.path.c_str());
+        if (!surf) {
+            LOG_ERROR(LogCategory::Assets, "SDL_LoadBMP failed (%s): %s", job.path.c_str(), SDL_GetError());
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoded.push_back(Decoded{ job.slot, job.generation, surf });
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "platform/SdlTexture.h"
+
+struct SDL_Surface;
+class SdlPlatform;
+
+/**
+ * Handle to a cached texture or image. Layout: [generation:16][slot + 1:16];
+ * 0 is never a valid handle.
+ */
+struct TextureHandle {
+    uint32_t id = 0;
+    bool Valid() const { return id != 0; }
+    bool operator==(const TextureHandle& o) const { return id == o.id; }
+};
+
+/**
+ * Texture cache with path-hashed dedup, reference counting and async decode.
+ *
+ * AcquireTexture() returns immediately; a worker thread reads and decodes the
+ * file into an SDL_Surface, and PumpUploads() (render thread) turns finished
+ * surfaces into SDL textures. Until then Get() returns nullptr and callers
+ * simply skip drawing.
+ *
+ * AcquireImage() shares the same entries but keeps the decoded surface on
+ * the CPU instead (e.g. sprites that get packed into an atlas). A path
+ * acquired both ways gets both.
+ */
+class AssetCache {
+public:
+    ~AssetCache() { Shutdown(); }
+
+    bool Init(SdlPlatform& platform);
+    void Shutdown();
+
+    // Same path -> same handle (ref count bumped). Pair with Release().
+    TextureHandle AcquireTexture(const std::string& path);
+    TextureHandle AcquireImage(const std::string& path);
+    void Release(TextureHandle h);
+
+    // Re-decode from disk; the old texture/image stays in place until the new
+    // one lands, and is kept if the file no longer decodes.
+    void Reload(TextureHandle h);
+
+    // Runs work() on the worker thread, then done() on the render thread
+    // from PumpUploads (e.g. decode + pack off-thread, upload on-thread).
+    void RunAsync(std::function<void()> work, std::function<void()> done);
+
+    // Render thread: upload up to maxUploads decoded surfaces and run finished
+    // RunAsync callbacks. Call once per frame.
+    void PumpUploads(int maxUploads = 8);
+
+    // Blocks until every queued decode has been uploaded (tools/headless).
+    void WaitIdle();
+
+    const SdlTexture* Get(TextureHandle h) const;
+    // Decoded pixels of an AcquireImage() entry (render thread, read only).
+    SDL_Surface* GetImage(TextureHandle h) const;
+    bool Failed(TextureHandle h) const;
+    // A decode for this entry is queued or not yet applied by PumpUploads.
+    bool Pending(TextureHandle h) const;
+
+private:
+    enum class State : uint8_t { Free, Loading, Ready, Failed };
+
+    struct Entry {
+        std::string path;
+        uint64_t hash = 0;
+        int refs = 0;
+        int pending = 0;            // decodes queued for this generation
+        uint16_t generation = 1;
+        State state = State::Free;
+        bool wantsTexture = false;
+        bool keepImage = false;
+        SdlTexture texture;
+        SDL_Surface* image = nullptr;
+    };
+
+    struct Job {
+        uint32_t slot = 0;
+        uint16_t generation = 0;
+        std::string path;
+
+        // Generic task (RunAsync) when set
+        std::function<void()> work;
+        std::function<void()> done;
+    };
+
+    struct Decoded {
+        uint32_t slot = 0;
+        uint16_t generation = 0;
+        SDL_Surface* surface = nullptr; // null = decode failed
+    };
+
+    static uint64_t HashPath(const std::string& path);
+    TextureHandle Acquire(const std::string& path, bool texture);
+    Entry* Resolve(TextureHandle h);
+    const Entry* Resolve(TextureHandle h) const;
+    void Enqueue(uint32_t slot);
+    void WorkerMain();
+
+    SdlPlatform* m_platform = nullptr;
+
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_freeSlots;
+    std::unordered_map<uint64_t, uint32_t> m_byHash;   // path hash -> slot
+
+    // Worker
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Job> m_jobs;
+    std::vector<Decoded> m_decoded;
+    std::vector<std::function<void()>> m_completed;   // RunAsync done callbacks
+    int m_inFlight = 0;         // queued + decoding + awaiting upload
+    bool m_quit = false;
+};
@@ -0,0 +1,174 @@
+#include "engine/AssetWatcher.h"
+
+#include "engine/Log.h"
+#include <filesystem>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// How long the watcher thread sleeps between checks.
+static constexpr int kInotifyWaitMs = 50;
+static constexpr auto kPollInterval = std::chrono::milliseconds(500);
+
+bool AssetWatcher::Start(const std::vector<std::string>& dirs, float debounceSeconds) {
+    Stop();
+
+    m_dirs = dirs;
+    m_debounce = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(debounceSeconds));
+
+#if defined(__linux__)
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd >= 0) {
+        for (const std::string& dir : m_dirs) {
+            const int wd = inotify_add_watch(m_inotifyFd, dir.c_str(),
+                IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+            if (wd >= 0) m_watchDirs[wd] = dir;
+        }
+        if (m_watchDirs.empty()) {
+            close(m_inotifyFd);
+            m_inotifyFd = -1;
+        }
+    }
+#endif
+
+    if (m_inotifyFd < 0) {
+        // Seed timestamps so startup doesn't report every file as changed.
+        m_lastWrite.clear();
+        PollDirectories();
+        m_pending.clear();
+    }
+
+    LOG_INFO(LogCategory::HotReload, "Asset watcher started (%s, %zu dirs)",
+        UsingInotify() ? "inotify" : "polling", m_dirs.size());
+
+    m_running = true;
+    m_thread = std::thread(&AssetWatcher::ThreadMain, this);
+    return true;
+}
+
+void AssetWatcher::Stop() {
+    if (m_running.exchange(false) && m_thread.joinable()) {
+        m_thread.join();
+    }
+
+#if defined(__linux__)
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+    }
+#endif
+    m_watchDirs.clear();
+    m_pending.clear();
+}
+
+void AssetWatcher::Drain(std::vector<AssetChange>& out) {
+    if (!m_hasReady.load(std::memory_order_acquire))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (AssetChange& c : m_ready) out.push_back(std::move(c));
+    m_ready.clear();
+    m_hasReady.store(false, std::memory_order_release);
+}
+
+void AssetWatcher::ThreadMain() {
+    Clock::time_point nextPoll = Clock::now();
+
+    while (m_running.load(std::memory_order_relaxed)) {
+        if (UsingInotify()) {
+            WaitInotify();
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kInotifyWaitMs));
+            if (Clock::now() >= nextPoll) {
+                nextPoll = Clock::now() + kPollInterval;
+                PollDirectories();
+            }
+        }
+
+        FlushDebounced();
+    }
+}
+
+void AssetWatcher::WaitInotify() {
+#if defined(__linux__)
+    pollfd pfd{ m_inotifyFd, POLLIN, 0 };
+    if (poll(&pfd, 1, kInotifyWaitMs) <= 0 || !(pfd.revents & POLLIN))
+        return;
+
+    alignas(inotify_event) char buf[4096];
+    while (true) {
+        const ssize_t len = read(m_inotifyFd, buf, sizeof(buf));
+        if (len <= 0) break;
+
+        for (char* p = buf; p < buf + len;) {
+            const inotify_event* ev = reinterpret_cast<const inotify_event*>(p);
+            p += sizeof(inotify_event) + ev->len;
+
+            if (ev->len == 0 || (ev->mask & IN_ISDIR)) continue;
+
+            auto it = m_watchDirs.find(ev->wd);
+            if (it == m_watchDirs.end()) continue;
+
+            Touch(it->second + "/" + ev->name);
+        }
+    }
+#endif
+}
+
+void AssetWatcher::PollDirectories() {
+    std::error_code ec;
+    for (const std::string& dir : m_dirs) {
+        for (const fs::directory_entry& entry : fs::directory_iterator(dir, ec)) {
+            if (!entry.is_regular_file(ec)) continue;
+
+            const long long t = (long long)entry.last_write_time(ec).time_since_epoch().count();
+            if (ec) continue;
+
+            const std::string path = dir + "/" + entry.path().filename().string();
+            auto it = m_lastWrite.find(path);
+            if (it == m_lastWrite.end()) {
+                m_lastWrite.emplace(path, t);
+                Touch(path);
+            }
+            else if (it->second != t) {
+                it->second = t;
+                Touch(path);
+            }
+        }
+    }
+}
+
+void AssetWatcher::Touch(const std::string& path) {
+    m_pending[path] = Clock::now();
+}
+
+void AssetWatcher::FlushDebounced() {
+    if (m_pending.empty()) return;
+
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (now - it->second < m_debounce) {
+            ++it;
+            continue;
+        }
+        m_ready.push_back(AssetChange{ it->first, KindFromPath(it->first) });
+        it = m_pending.erase(it);
+    }
+    if (!m_ready.empty()) m_hasReady.store(true, std::memory_order_release);
+}
+
+AssetKind AssetWatcher::KindFromPath(const std::string& path) {
+    const std::string ext = fs::path(path).extension().string();
+    if (ext == ".json") return AssetKind::Config;
+    if (ext == ".csv") return AssetKind::Map;
+    if (ext == ".bmp") return AssetKind::Texture;
+    return AssetKind::Other;
+}
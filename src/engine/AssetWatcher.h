@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum class AssetKind : uint8_t { Config, Map, Texture, Other };
+
+struct AssetChange {
+    std::string path;   // "<watched dir>/<file name>"
+    AssetKind kind = AssetKind::Other;
+};
+
+/**
+ * Background file watcher for asset directories.
+ *
+ * Uses inotify on Linux and falls back to polling last_write_time elsewhere
+ * (or if inotify is unavailable). Bursts of writes to the same file are
+ * debounced into a single change, which is queued for the main thread to
+ * pick up with Drain(). Nothing here runs on the simulation tick.
+ */
+class AssetWatcher {
+public:
+    ~AssetWatcher() { Stop(); }
+
+    bool Start(const std::vector<std::string>& dirs, float debounceSeconds = 0.2f);
+    void Stop();
+
+    // Main thread: appends ready changes to out. Cheap when nothing changed.
+    void Drain(std::vector<AssetChange>& out);
+
+    bool UsingInotify() const { return m_inotifyFd >= 0; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void ThreadMain();
+    void WaitInotify();
+    void PollDirectories();
+    void Touch(const std::string& path);
+    void FlushDebounced();
+
+    static AssetKind KindFromPath(const std::string& path);
+
+    std::vector<std::string> m_dirs;
+    Clock::duration m_debounce{};
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{ false };
+
+    // inotify (Linux)
+    int m_inotifyFd = -1;
+    std::unordered_map<int, std::string> m_watchDirs; // wd -> dir
+
+    // polling fallback
+    std::unordered_map<std::string, long long> m_lastWrite;
+
+    // watcher-thread only: path -> time of most recent event
+    std::unordered_map<std::string, Clock::time_point> m_pending;
+
+    std::mutex m_mutex;
+    std::vector<AssetChange> m_ready;
+    std::atomic<bool> m_hasReady{ false };
+};
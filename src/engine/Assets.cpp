@@ -1,15 +1,137 @@
 #include "engine/Assets.h"
 #include <SDL.h>
+#include <filesystem>
+#include <memory>
 #include <string>
 #include "engine/Paths.h"
+#include "engine/AllocTracker.h"
+
+static constexpr int kAtlasPageSize = 2048;
 
 bool Assets::Init(SdlPlatform& platform)
 {
-    return m_player.LoadBMP(platform, AssetPath("assets/player.bmp").c_str());
+    AllocScope allocScope(AllocTag::Assets);
+
+    m_platform = &platform;
+    if (!m_cache.Init(platform))
+        return false;
+
+    // Returns immediately; sprites are decoded and packed on the cache worker.
+    ScanSprites(std::string());
+    return true;
+}
+
+void Assets::ScanSprites(const std::string& changedPath)
+{
+    auto paths = std::make_shared<std::vector<std::string>>();
+    const std::string dir = AssetPath("assets");
+
+    m_cache.RunAsync(
+        [paths, dir]() {
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+                if (entry.path().extension() == ".bmp") paths->push_back(entry.path().string());
+            }
+        },
+        [this, paths, changedPath]() { SyncSprites(*paths, changedPath); });
+}
+
+void Assets::SyncSprites(const std::vector<std::string>& paths, const std::string& changedPath)
+{
+    std::unordered_map<std::string, TextureHandle> images;
+    for (const std::string& path : paths) {
+        auto it = m_spriteImages.find(path);
+        if (it == m_spriteImages.end()) {
+            images[path] = m_cache.AcquireImage(path);
+            continue;
+        }
+        // The watcher reports paths relative to the working dir, the scan absolute ones.
+        std::error_code ec;
+        if (!changedPath.empty() && std::filesystem::equivalent(path, changedPath, ec)) {
+            m_cache.Reload(it->second);
+        }
+        images[path] = it->second;
+        m_spriteImages.erase(it);
+    }
+
+    // Whatever is left was deleted from disk.
+    for (auto& [path, handle] : m_spriteImages) m_cache.Release(handle);
+    m_spriteImages.swap(images);
+    m_atlasDirty = true;
+}
+
+void Assets::Update()
+{
+    m_cache.PumpUploads();
+    if (!m_atlasDirty || m_atlasPacking) return;
+
+    // Pack once every sprite has landed (or failed) so a reload repacks once.
+    for (const auto& [path, handle] : m_spriteImages) {
+        if (m_cache.Pending(handle)) return;
+    }
+    PackAtlas();
+}
+
+void Assets::PackAtlas()
+{
+    AllocScope allocScope(AllocTag::Assets);
+
+    // The worker packs private copies; the cache's images stay render-thread only.
+    auto built = std::make_shared<AtlasBuildResult>();
+    for (const auto& [path, handle] : m_spriteImages) {
+        SDL_Surface* image = m_cache.GetImage(handle);
+        if (!image) continue;
+        SDL_Surface* copy = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+        if (!copy) continue;
+        built->names.push_back(std::filesystem::path(path).stem().string());
+        built->sources.push_back(copy);
+    }
+    m_atlasDirty = false;
+    m_atlasPacking = true;
+
+    m_cache.RunAsync(
+        [built]() { BuildAtlas(kAtlasPageSize, *built); },
+        [this, built]() {
+            m_atlasPacking = false;
+            if (m_atlas.Upload(*m_platform, *built)) {
+                m_playerSprite = m_atlas.Find("player");
+            }
+        });
+}
+
+SpriteView Assets::Sprite(int index) const
+{
+    SpriteView view;
+    const AtlasSprite* sprite = m_atlas.Sprite(index);
+    if (!sprite || sprite->page < 0) return view;
+
+    view.texture = &m_atlas.Page(sprite->page);
+    view.rect = sprite->rect;
+    return view;
+}
+
+bool Assets::Reload(SdlPlatform& platform, const std::string& changedPath)
+{
+    (void)platform;
+    AllocScope allocScope(AllocTag::Assets);
+
+    // Rescan for added/removed files and re-decode the changed one; the
+    // atlas repacks once it lands. A file that fails to decode keeps its
+    // previous image in the cache.
+    if (std::filesystem::path(changedPath).extension() == ".bmp") {
+        ScanSprites(changedPath);
+        return true;
+    }
+    return false;
 }
 
 
 void Assets::Shutdown()
 {
-    m_player.Destroy();
+    m_cache.Shutdown();
+    m_spriteImages.clear();
+    m_atlas.Destroy();
+    m_atlasDirty = false;
+    m_atlasPacking = false;
+    m_playerSprite = -1;
 }
@@ -1,18 +1,59 @@
 #pragma once
-#include "platform/SdlTexture.h"
+#include "engine/AssetCache.h"
+#include "engine/TextureAtlas.h"
+#include <string>
+#include <unordered_map>
 
 class SdlPlatform;
 
+// A sprite resolved against the atlas: page texture + source rect.
+struct SpriteView {
+    const SdlTexture* texture = nullptr;    // null until the atlas is uploaded
+    AtlasRect rect;
+
+    int Width() const { return rect.w; }
+    int Height() const { return rect.h; }
+};
+
 /**
  * Simple asset container.
- * For now this loads only the player BMP. Expand as the project grows.
+ * Every BMP sprite in assets/ is acquired as an AssetCache image; once they
+ * have all decoded they are packed into a texture atlas on the cache worker
+ * and uploaded on the render thread. Expand as the project grows.
  */
 class Assets {
 public:
+    ~Assets() { Shutdown(); }
+
     bool Init(SdlPlatform& platform);
     void Shutdown();
 
-    const SdlTexture& Player() const { return m_player; }
+    // Render thread: finish pending uploads and repack the atlas when its
+    // sprites have changed.
+    void Update();
+
+    // Rebuilds whatever depends on changedPath. Returns true if a reload was queued.
+    bool Reload(SdlPlatform& platform, const std::string& changedPath);
+
+    // Empty (0x0, no texture) until the atlas has been uploaded.
+    SpriteView Player() const { return Sprite(m_playerSprite); }
+    SpriteView Sprite(int index) const;
+
+    const TextureAtlas& Atlas() const { return m_atlas; }
+    AssetCache& Cache() { return m_cache; }
+
 private:
-    SdlTexture m_player;
+    // Rescans assets/ off-thread, then syncs m_spriteImages; changedPath (if
+    // any) is re-decoded.
+    void ScanSprites(const std::string& changedPath);
+    void SyncSprites(const std::vector<std::string>& paths, const std::string& changedPath);
+    void PackAtlas();
+
+    SdlPlatform* m_platform = nullptr;
+    AssetCache m_cache;
+    TextureAtlas m_atlas;
+    std::unordered_map<std::string, TextureHandle> m_spriteImages;  // path -> image
+    bool m_atlasDirty = false;      // sprites changed since the last pack
+    bool m_atlasPacking = false;    // a pack is running on the worker
+    int m_playerSprite = -1;
 };
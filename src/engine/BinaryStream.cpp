@@ -0,0 +1,26 @@
+#include "engine/BinaryStream.h"
+
+#include <cstdio>
+
+bool WriteBinaryFile(const char* path, const std::vector<uint8_t>& data) {
+    FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+
+    const bool ok = std::fwrite(data.data(), 1, data.size(), f) == data.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+bool ReadBinaryFile(const char* path, std::vector<uint8_t>& out) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f) return false;
+
+    out.clear();
+    uint8_t chunk[16 * 1024];
+    size_t n = 0;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        out.insert(out.end(), chunk, chunk + n);
+    }
+    const bool ok = !std::ferror(f);
+    std::fclose(f);
+    return ok;
+}
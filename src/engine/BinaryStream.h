@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Minimal binary serialization for save states.
+ *
+ * Values are copied as raw bytes in native layout (little-endian on every
+ * platform we ship), so only trivially copyable types are accepted.
+ * Arrays are prefixed with a uint32 element count.
+ *
+ * BinaryReader never reads past the end: the first short read sets a sticky
+ * failure flag and every later read returns false.
+ */
+class BinaryWriter {
+public:
+    // Appends to out (callers keep the vector around to reuse its capacity).
+    explicit BinaryWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void Bytes(const void* data, size_t size) {
+        if (size == 0) return;
+        const size_t at = m_out.size();
+        m_out.resize(at + size);
+        std::memcpy(m_out.data() + at, data, size);
+    }
+
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "raw copy only");
+        Bytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void WriteArray(const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "raw copy only");
+        Write<uint32_t>((uint32_t)count);
+        Bytes(data, sizeof(T) * count);
+    }
+
+    size_t Size() const { return m_out.size(); }
+
+    // Overwrites a value written earlier (e.g. a size patched in at the end).
+    template <typename T>
+    void Patch(size_t offset, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "raw copy only");
+        std::memcpy(m_out.data() + offset, &value, sizeof(T));
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    bool Bytes(void* out, size_t size) {
+        if (!m_ok || size > m_size - m_pos) {
+            m_ok = false;
+            return false;
+        }
+        if (size > 0) std::memcpy(out, m_data + m_pos, size);
+        m_pos += size;
+        return true;
+    }
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "raw copy only");
+        return Bytes(&value, sizeof(T));
+    }
+
+    // Fails (without allocating) if the count exceeds maxCount or the data left.
+    template <typename T>
+    bool ReadArray(std::vector<T>& out, size_t maxCount) {
+        static_assert(std::is_trivially_copyable_v<T>, "raw copy only");
+        uint32_t count = 0;
+        if (!Read(count)) return false;
+        if (count > maxCount || (size_t)count * sizeof(T) > m_size - m_pos) {
+            m_ok = false;
+            return false;
+        }
+        out.resize(count);
+        return Bytes(out.data(), sizeof(T) * count);
+    }
+
+    bool Ok() const { return m_ok; }
+    bool AtEnd() const { return m_pos == m_size; }
+    size_t Remaining() const { return m_size - m_pos; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    bool m_ok = true;
+};
+
+// Whole-file helpers for checkpoints.
+bool WriteBinaryFile(const char* path, const std::vector<uint8_t>& data);
+bool ReadBinaryFile(const char* path, std::vector<uint8_t>& out);
@@ -3,25 +3,29 @@
 
 class Camera2D {
 public:
-    void SetPosition(const Vec2& p) { m_pos = p; }
+    // World -> screen as one affine: screen = world * scale + offset.
+    struct ScreenTransform {
+        float scale = 1.0f;
+        Vec2 offset{ 0.0f, 0.0f };
+
+        Vec2 Apply(const Vec2& world) const { return world * scale + offset; }
+    };
+
+    void SetPosition(const Vec2& p) { m_pos = p; UpdateTransform(); }
     const Vec2& Position() const { return m_pos; }
 
-    void SetZoom(float z) { m_zoom = z; }
+    void SetZoom(float z) { m_zoom = z; UpdateTransform(); }
     float Zoom() const { return m_zoom; }
 
-    void SetShakeOffset(const Vec2& s) { m_shake = s; }
+    void SetShakeOffset(const Vec2& s) { m_shake = s; UpdateTransform(); }
     const Vec2& ShakeOffset() const { return m_shake; }
 
+    // Cached on every change; batch transforms should copy it once and Apply().
+    const ScreenTransform& WorldToScreenTransform() const { return m_toScreen; }
+
     // Convert world position to screen position (pixels)
     Vec2 WorldToScreen(const Vec2& world) const {
-        // World relative to camera origin
-        Vec2 local = world - m_pos;
-
-        // Apply zoom around camera origin
-        local = local * m_zoom;
-
-        // Apply screen-space shake
-        return local + m_shake;
+        return m_toScreen.Apply(world);
     }
 
     // Convert screen pixel position to world (useful later)
@@ -30,8 +34,23 @@ public:
         return (unshaken * (1.0f / m_zoom)) + m_pos;
     }
 
+    // World-space area shown by a viewW x viewH view (current zoom and shake),
+    // grown by marginPx screen pixels on every side for things that extend
+    // past their position (sprites, interpolation, AI that's about to appear).
+    Aabb ViewRect(int viewW, int viewH, float marginPx = 0.0f) const {
+        return Aabb{ ScreenToWorld({ -marginPx, -marginPx }),
+                     ScreenToWorld({ viewW + marginPx, viewH + marginPx }) };
+    }
+
 private:
+    // (world - pos) * zoom + shake, folded into scale + offset
+    void UpdateTransform() {
+        m_toScreen.scale = m_zoom;
+        m_toScreen.offset = m_shake - m_pos * m_zoom;
+    }
+
     Vec2 m_pos{ 0.0f, 0.0f };     // top-left in world space
     Vec2 m_shake{ 0.0f, 0.0f };   // screen-space pixels
     float m_zoom = 1.0f;
+    ScreenTransform m_toScreen;
 };
@@ -1,62 +1,145 @@
 #include "engine/Config.h"
+#include "engine/Json.h"
+#include "engine/AllocTracker.h"
+#include "engine/Log.h"
 
 #include <fstream>
 #include <string>
+#include <string_view>
 
 /**
- * Tiny JSON-ish float extractor.
- * We keep it lightweight for now (no dependency). It expects keys like:
- *   "player_speed": 220.0
- *
- * NOTE: This is not a full JSON parser; it's good enough for a small prototype.
+ * Declarative schema: each scalar config value is bound to a dotted JSON
+ * path and the change bit it belongs to. "[]" in a path stands for "any
+ * element of the enclosing array".
  */
-static bool ExtractFloat(const std::string& text, const char* key, float& out) {
-    size_t pos = text.find(key);
-    if (pos == std::string::npos) return false;
-    pos = text.find(':', pos);
-    if (pos == std::string::npos) return false;
-
-    // std::stof stops at the first non-number (comma/brace), which works for our format.
-    out = std::stof(text.substr(pos + 1));
-    return true;
-}
+struct FloatField {
+    const char* path;
+    float (*get)(const GameConfig&);
+    void (*set)(GameConfig&, float);
+    uint32_t change;
+};
 
-static bool ExtractVec2(const std::string& txt, const char* key, Vec2& out) {
-    size_t pos = txt.find(key);
-    if (pos == std::string::npos) return false;
+static const FloatField kFloatFields[] = {
+    { "player_speed",
+      [](const GameConfig& c) { return c.playerSpeed; },
+      [](GameConfig& c, float v) { c.playerSpeed = v; }, kConfigPlayerSpeed },
+    { "enemy_speed",
+      [](const GameConfig& c) { return c.enemySpeed; },
+      [](GameConfig& c, float v) { c.enemySpeed = v; }, kConfigEnemySpeed },
+    { "world_width",
+      [](const GameConfig& c) { return c.worldWidth; },
+      [](GameConfig& c, float v) { c.worldWidth = v; }, kConfigWorldSize },
+    { "world_height",
+      [](const GameConfig& c) { return c.worldHeight; },
+      [](GameConfig& c, float v) { c.worldHeight = v; }, kConfigWorldSize },
+    { "player_spawn.x",
+      [](const GameConfig& c) { return c.playerSpawn.x; },
+      [](GameConfig& c, float v) { c.playerSpawn.x = v; }, kConfigPlayerSpawn },
+    { "player_spawn.y",
+      [](const GameConfig& c) { return c.playerSpawn.y; },
+      [](GameConfig& c, float v) { c.playerSpawn.y = v; }, kConfigPlayerSpawn },
+};
 
-    auto xPos = txt.find("\"x\"", pos);
-    auto yPos = txt.find("\"y\"", pos);
-    if (xPos == std::string::npos || yPos == std::string::npos) return false;
+// Enemy spawn list: "enemies" is an array of { "x": .., "y": .. }.
+static constexpr const char* kEnemyElementPath = "enemies.[]";
+static constexpr const char* kEnemyXPath = "enemies.[].x";
+static constexpr const char* kEnemyYPath = "enemies.[].y";
 
-    out.x = std::stof(txt.substr(txt.find(':', xPos) + 1));
-    out.y = std::stof(txt.substr(txt.find(':', yPos) + 1));
-    return true;
-}
+/**
+ * SAX handler that tracks the current path as a small stack of views into
+ * the source text (objects contribute their current key, arrays "[]") and
+ * writes matching values straight into the config.
+ */
+class ConfigHandler : public JsonSaxHandler {
+public:
+    explicit ConfigHandler(GameConfig& cfg) : m_cfg(cfg) {}
 
-static void ExtractEnemySpawns(const std::string& txt,
-    std::vector<SpawnPoint>& out) {
-    size_t pos = txt.find("\"enemies\"");
-    if (pos == std::string::npos) return;
+    bool OnBeginObject() override {
+        if (MatchPath(kEnemyElementPath)) {
+            m_spawn = SpawnPoint{};
+        }
+        return Push({});
+    }
 
-    size_t cur = pos;
-    while (true) {
-        auto xPos = txt.find("\"x\"", cur);
-        auto yPos = txt.find("\"y\"", cur);
-        if (xPos == std::string::npos || yPos == std::string::npos)
-            break;
+    bool OnEndObject() override {
+        Pop();
+        if (MatchPath(kEnemyElementPath)) {
+            m_cfg.enemySpawns.push_back(m_spawn);
+        }
+        return true;
+    }
 
-        SpawnPoint sp;
-        sp.pos.x = std::stof(txt.substr(txt.find(':', xPos) + 1));
-        sp.pos.y = std::stof(txt.substr(txt.find(':', yPos) + 1));
-        out.push_back(sp);
+    bool OnBeginArray() override {
+        if (MatchPath("enemies")) {
+            m_cfg.enemySpawns.clear();
+        }
+        return Push("[]");
+    }
 
-        cur = yPos + 1;
+    bool OnEndArray() override {
+        Pop();
+        return true;
+    }
+
+    bool OnKey(std::string_view key) override {
+        // An object's segment is its current key.
+        m_path[m_depth - 1] = key;
+        return true;
+    }
+
+    bool OnNumber(double v) override {
+        const float f = (float)v;
+        if (MatchPath(kEnemyXPath)) m_spawn.pos.x = f;
+        else if (MatchPath(kEnemyYPath)) m_spawn.pos.y = f;
+        else {
+            for (const FloatField& field : kFloatFields) {
+                if (MatchPath(field.path)) {
+                    field.set(m_cfg, f);
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    static constexpr int kMaxPath = 8;
+
+    bool Push(std::string_view segment) {
+        if (m_depth >= kMaxPath) return false;
+        m_path[m_depth++] = segment;
+        return true;
     }
-}
+
+    void Pop() {
+        if (m_depth > 0) --m_depth;
+    }
+
+    // Compares the current path with a dotted path.
+    bool MatchPath(std::string_view dotted) const {
+        int seg = 0;
+        while (!dotted.empty()) {
+            if (seg >= m_depth) return false;
+            const size_t dot = dotted.find('.');
+            const std::string_view part = dotted.substr(0, dot);
+            if (m_path[seg] != part) return false;
+            ++seg;
+            dotted = (dot == std::string_view::npos) ? std::string_view{} : dotted.substr(dot + 1);
+        }
+        return seg == m_depth;
+    }
+
+    GameConfig& m_cfg;
+    std::string_view m_path[kMaxPath];
+    int m_depth = 0;
+
+    SpawnPoint m_spawn{};
+};
 
 bool LoadGameConfig(const char* path, GameConfig& outCfg) {
-    std::ifstream f(path);
+    AllocScope allocScope(AllocTag::Config);
+
+    std::ifstream f(path, std::ios::binary);
     if (!f.is_open()) {
         return false;
     }
@@ -66,14 +149,38 @@ bool LoadGameConfig(const char* path, GameConfig& outCfg) {
         std::istreambuf_iterator<char>()
     );
 
-    ExtractFloat(txt, "player_speed", outCfg.playerSpeed);
-    ExtractFloat(txt, "enemy_speed", outCfg.enemySpeed);
-    ExtractFloat(txt, "world_width", outCfg.worldWidth);
-    ExtractFloat(txt, "world_height", outCfg.worldHeight);
-
-    ExtractVec2(txt, "player_spawn", outCfg.playerSpawn);
-    outCfg.enemySpawns.clear();
-    ExtractEnemySpawns(txt, outCfg.enemySpawns);
+    // Parse into a copy so a half-written file never leaves partial values.
+    GameConfig parsed = outCfg;
+    ConfigHandler handler(parsed);
+    JsonError err{};
+    if (!ParseJson(txt, handler, &err)) {
+        LOG_ERROR(LogCategory::Config, "%s: %s at offset %zu", path,
+            err.message ? err.message : "parse error", err.offset);
+        return false;
+    }
 
+    outCfg = std::move(parsed);
     return true;
 }
+
+uint32_t DiffGameConfig(const GameConfig& a, const GameConfig& b) {
+    uint32_t changed = 0;
+    for (const FloatField& field : kFloatFields) {
+        if (field.get(a) != field.get(b)) changed |= field.change;
+    }
+
+    if (a.enemySpawns.size() != b.enemySpawns.size()) {
+        changed |= kConfigEnemySpawns;
+    }
+    else {
+        for (size_t i = 0; i < a.enemySpawns.size(); ++i) {
+            const Vec2& pa = a.enemySpawns[i].pos;
+            const Vec2& pb = b.enemySpawns[i].pos;
+            if (pa.x != pb.x || pa.y != pb.y) {
+                changed |= kConfigEnemySpawns;
+                break;
+            }
+        }
+    }
+    return changed;
+}
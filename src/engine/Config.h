@@ -3,6 +3,7 @@
  * This stays intentionally small while the engine is a prototype.
  */
 #pragma once
+#include <cstdint>
 #include <vector>
 #include "engine/Math.h"
 
@@ -20,5 +21,20 @@ struct GameConfig {
     std::vector<SpawnPoint> enemySpawns;
 };
 
+// Field groups reported by DiffGameConfig (bitmask).
+enum ConfigChange : uint32_t {
+    kConfigPlayerSpeed = 1u << 0,
+    kConfigEnemySpeed  = 1u << 1,
+    kConfigWorldSize   = 1u << 2,
+    kConfigPlayerSpawn = 1u << 3,
+    kConfigEnemySpawns = 1u << 4,
 
+    kConfigAll = 0xFFFFFFFFu
+};
+
+// Parses path into outCfg. Keys missing from the file keep their current
+// value. On a parse error outCfg is left untouched and false is returned.
 bool LoadGameConfig(const char* path, GameConfig& outCfg);
+
+// Returns the ConfigChange bits that differ between a and b.
+uint32_t DiffGameConfig(const GameConfig& a, const GameConfig& b);
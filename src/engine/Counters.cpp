@@ -0,0 +1,71 @@
+#include "engine/Counters.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Constant-initialized, so counters in any translation unit can register
+// during static initialization.
+static std::atomic<Counter*> s_head{ nullptr };
+static std::atomic<int> s_count{ 0 };
+
+Counter::Counter(const char* name) : m_name(name) {
+    m_index = s_count.fetch_add(1, std::memory_order_relaxed);
+    Counter* head = s_head.load(std::memory_order_relaxed);
+    do {
+        m_next = head;
+    } while (!s_head.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void Counter::EndFrame() {
+    m_last = m_value.exchange(0, std::memory_order_relaxed);
+    if (m_last > m_max) m_max = m_last;
+    m_total += m_last;
+}
+
+CounterScope::CounterScope() : m_values((size_t)s_count.load(std::memory_order_acquire)), m_prev(t_current) {
+    t_current = this;
+}
+
+CounterScope::~CounterScope() {
+    t_current = m_prev;
+}
+
+void CounterScope::EndFrame() {
+    for (Values& v : m_values) {
+        v.last = v.value;
+        v.value = 0;
+        if (v.last > v.max) v.max = v.last;
+        v.total += v.last;
+    }
+}
+
+int64_t CounterScope::Total(const char* name) const {
+    const Counter* c = Counters::Find(name);
+    return (c && c->Index() < (int)m_values.size()) ? m_values[c->Index()].total : 0;
+}
+
+namespace Counters {
+    const Counter* First() {
+        return s_head.load(std::memory_order_acquire);
+    }
+
+    const Counter* Find(const char* name) {
+        for (const Counter* c = First(); c; c = c->Next()) {
+            if (std::strcmp(c->Name(), name) == 0) return c;
+        }
+        return nullptr;
+    }
+
+    void EndFrame() {
+        for (Counter* c = s_head.load(std::memory_order_acquire); c; c = c->Next()) {
+            c->EndFrame();
+        }
+    }
+
+    void Print() {
+        for (const Counter* c = First(); c; c = c->Next()) {
+            std::printf("[COUNTER] %-28s total=%lld max/frame=%lld\n",
+                c->Name(), (long long)c->Total(), (long long)c->MaxFrame());
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Named workload counter (draw calls, A* expansions, collision pairs...).
+ *
+ * Declare counters with static storage duration next to the code they
+ * measure; they register themselves in a global list at startup:
+ *
+ *     static Counter s_astarCalls("astar.calls");
+ *     s_astarCalls.Add();
+ *
+ * Add() is a relaxed atomic increment and safe from any thread.
+ * Counters::EndFrame() (main thread, once per frame) closes the frame.
+ * A thread running its own simulation (batch runs) installs a CounterScope
+ * instead, so its counts stay separate and EndFrame never races.
+ */
+class Counter {
+public:
+    explicit Counter(const char* name);
+
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    void Add(int64_t n = 1);
+
+    const char* Name() const { return m_name; }
+    int64_t LastFrame() const { return m_last; }
+    int64_t MaxFrame() const { return m_max; }
+    int64_t Total() const { return m_total; }
+
+    Counter* Next() const { return m_next; }
+    int Index() const { return m_index; }  // registration order, 0-based
+
+    // Moves the running value into LastFrame/MaxFrame/Total.
+    void EndFrame();
+
+private:
+    const char* m_name;
+    std::atomic<int64_t> m_value{ 0 };
+    int64_t m_last = 0;
+    int64_t m_max = 0;
+    int64_t m_total = 0;
+    Counter* m_next = nullptr;
+    int m_index = 0;
+};
+
+/**
+ * Thread-local counter values. While a scope is alive, Add() on its thread
+ * goes here (plain adds, no atomics) instead of the shared counters; scopes
+ * nest and the destructor restores the previous one.
+ */
+class CounterScope {
+public:
+    CounterScope();
+    ~CounterScope();
+
+    CounterScope(const CounterScope&) = delete;
+    CounterScope& operator=(const CounterScope&) = delete;
+
+    void EndFrame();
+
+    int64_t Total(const char* name) const;      // 0 if not registered
+
+    static CounterScope* Current() { return t_current; }
+
+private:
+    friend class Counter;
+
+    struct Values {
+        int64_t value = 0;
+        int64_t last = 0;
+        int64_t max = 0;
+        int64_t total = 0;
+    };
+    std::vector<Values> m_values;   // by Counter::Index()
+    CounterScope* m_prev = nullptr;
+
+    static inline thread_local CounterScope* t_current = nullptr;
+};
+
+inline void Counter::Add(int64_t n) {
+    CounterScope* scope = CounterScope::t_current;
+    if (scope && m_index < (int)scope->m_values.size()) {
+        scope->m_values[m_index].value += n;
+        return;
+    }
+    m_value.fetch_add(n, std::memory_order_relaxed);
+}
+
+namespace Counters {
+    const Counter* First();
+    const Counter* Find(const char* name);      // nullptr if not registered
+
+    void EndFrame();
+
+    // Lifetime summary, one line per counter (headless / CI logs).
+    void Print();
+}
@@ -1,10 +1,14 @@
 #pragma once
 #include <cstdint>
 #include "engine/Math.h"
+#include "engine/FrameStats.h"
+
+class DebugEntitySource;
 
 struct DebugState {
     // Start with debug UI hidden; toggle in-game (Tab).
     bool showUI = false;
+    int uiRefreshInterval = 1;      // rebuild the overlay every N frames (1 = every frame)
     bool showGrid = true;
     bool showColliders = false;
     bool pause = false;
@@ -16,6 +20,42 @@ struct DebugState {
     float dt = 0.0f;
     float fps = 0.0f;
 
+    // Fixed-step timing (written by App)
+    float tickRate = 60.0f;
+    int   substeps = 0;             // updates run last frame
+    int   maxSubsteps = 0;
+    float updateMs = 0.0f;          // smoothed cost of one update
+    float updateBudgetMs = 0.0f;    // fixedDt in ms
+    float timeDilation = 1.0f;      // simulated / real time over the last second
+    float droppedSeconds = 0.0f;    // total sim time discarded (clamps + catch-up cap)
+    float aiRepathScale = 1.0f;     // >1 while AI is throttled to keep up
+    bool  deterministic = false;    // no wall-clock throttling, per-tick state hash
+    uint64_t stateHash = 0;         // Game::ComputeStateHash after the last step
+
+    // Frame-time history (ms, written by App)
+    FrameTimeHistory frameTimes;    // full frame (platform dt)
+    FrameTimeHistory updateTimes;   // one fixed step each
+    FrameTimeHistory renderTimes;   // game + ImGui draw submission
+    FrameTimeHistory presentTimes;  // SDL_RenderPresent
+
+    // Render resolution (written by App)
+    int   renderW = 0;              // scene resolution (view size)
+    int   renderH = 0;
+    float renderScale = 1.0f;       // dynamic resolution share
+    float sceneMs = 0.0f;           // smoothed scene cost, flush included
+
+    // AI level-of-detail scheduling
+    bool aiLodEnabled = true;
+    int  aiLodInterval = 4;         // far/off-screen enemies tick every Nth step
+    int  aiTicked = 0;              // enemies updated last step
+    int  aiSkipped = 0;             // enemies deferred last step
+
+    // Per-tick frame arena
+    int arenaUsedBytes = 0;         // used by the last step
+    int arenaHighWaterBytes = 0;
+    int arenaCapacityBytes = 0;
+    int arenaOverflows = 0;         // allocations that fell back to the heap
+
     // Read-only stats
     Vec2 playerPos{ 0,0 };
     Vec2 cameraPos{ 0,0 };
@@ -33,11 +73,14 @@ struct DebugState {
     // Actions
     bool requestReloadConfig = false;
 
-    // Entity inspector
+    // Entity inspector (rows are pulled lazily from entitySource by DebugUI)
     uint32_t selectedEntityId = 0;
+    const DebugEntitySource* entitySource = nullptr;
 
     struct EntityDebugRow {
         uint32_t id = 0;
+        uint32_t slot = 0;          // id split per EntityPool's layout
+        uint32_t generation = 0;
         int type = 0;    // 0=player, 1=enemy
         float x = 0.0f;
         float y = 0.0f;
@@ -45,13 +88,25 @@ struct DebugState {
         int ai = 0;      // 0=idle, 1=seek (enemy only)
     };
 
-    static constexpr int kMaxDebugEntities = 256;
-    int debugEntityCount = 0;
-    EntityDebugRow debugEntities[kMaxDebugEntities];
-
     int playerMaxHealth = 3;
     float hitKnockback = 280.0f;     // units/sec impulse
     float invulnSeconds = 0.75f;
 
     bool showPaths = true;
 };
+
+/**
+ * Read-only view of the live entity set for the inspector.
+ * Queried only while the Entities window is drawn, so it costs nothing when
+ * the overlay is hidden. Called on the main thread between updates.
+ */
+class DebugEntitySource {
+public:
+    virtual ~DebugEntitySource() = default;
+
+    virtual int EntityCount() const = 0;
+    // index in [0, EntityCount()); dense order, may change as entities die
+    virtual bool EntityRow(int index, DebugState::EntityDebugRow& out) const = 0;
+    // Handle lookup; false once the entity is destroyed
+    virtual bool FindEntity(uint32_t id, DebugState::EntityDebugRow& out) const = 0;
+};
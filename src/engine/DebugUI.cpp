@@ -9,12 +9,110 @@
 
 #include <SDL.h>
 #include "DebugState.h"
+#include "engine/AllocTracker.h"
+#include "engine/Counters.h"
+#include <algorithm>
+#include <cfloat>
 #include <cstdio>
 
+#if defined(MINI_ENGINE_TRACK_ALLOCS) && MINI_ENGINE_TRACK_ALLOCS
+// Route ImGui's heap through operator new so it shows up under its own tag.
+static void* ImGuiTrackedAlloc(size_t size, void*) {
+    AllocScope allocScope(AllocTag::ImGui);
+    return ::operator new(size);
+}
+
+static void ImGuiTrackedFree(void* p, void*) {
+    if (p) ::operator delete(p);
+}
+#endif
+
+// Rolling percentiles + plot for each timed stage; the frame row also shows
+// the lifetime histogram.
+static void DrawFrameTimes(const DebugState& dbg) {
+    if (!ImGui::CollapsingHeader("Frame times")) return;
+
+    const float budget = dbg.updateBudgetMs;
+    struct Stage { const char* name; const FrameTimeHistory* h; };
+    const Stage stages[] = {
+        { "frame", &dbg.frameTimes },
+        { "update", &dbg.updateTimes },
+        { "render", &dbg.renderTimes },
+        { "present", &dbg.presentTimes },
+    };
+
+    for (const Stage& st : stages) {
+        const FrameTimeSummary s = st.h->SummarizeWindow(budget);
+        ImGui::Text("%-7s p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms  hitches %d",
+            st.name, s.p50, s.p95, s.p99, s.max, s.hitches);
+
+        char overlay[32];
+        std::snprintf(overlay, sizeof(overlay), "%.2f ms", st.h->Last());
+        ImGui::PushID(st.name);
+        ImGui::PlotLines("##plot", st.h->Window(), st.h->WindowCount(), st.h->WindowOffset(),
+            overlay, 0.0f, budget * 2.0f, ImVec2(0, 40));
+        ImGui::PopID();
+    }
+
+    // Lifetime distribution up to 2x budget, re-binned to 1 ms columns.
+    float bins[64] = {};
+    const int perBin = (int)(1.0f / FrameTimeHistory::kBucketMs);
+    const int binCount = std::min(64, std::max(1, (int)(budget * 2.0f)));
+    const uint32_t* hist = dbg.frameTimes.Histogram();
+    for (int b = 0; b < binCount * perBin && b < FrameTimeHistory::kBuckets; ++b) {
+        bins[b / perBin] += (float)hist[b];
+    }
+    ImGui::PlotHistogram("frame ms", bins, binCount, 0, "lifetime (1 ms bins)", 0.0f, FLT_MAX, ImVec2(0, 50));
+}
+
+// Virtualized entity list: only rows inside the visible range are fetched
+// from the source, so scene size doesn't matter.
+static void DrawEntityInspector(DebugState& dbg) {
+    const DebugEntitySource* source = dbg.entitySource;
+    const int count = source ? source->EntityCount() : 0;
+    ImGui::Text("%d entities", count);
+
+    const float detailsHeight = ImGui::GetTextLineHeightWithSpacing() * 4.0f;
+    if (ImGui::BeginChild("EntityList", ImVec2(0, -detailsHeight), ImGuiChildFlags_Borders)) {
+        ImGuiListClipper clipper;
+        clipper.Begin(count);
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                DebugState::EntityDebugRow e;
+                if (!source->EntityRow(i, e)) continue;
+
+                const char* typeName = (e.type == 0) ? "Player" : (e.type == 1) ? "Enemy" : "Pickup";
+
+                char label[64];
+                std::snprintf(label, sizeof(label), "%s #%u##%u", typeName, e.slot, e.id);
+
+                bool selected = (dbg.selectedEntityId == e.id);
+                if (ImGui::Selectable(label, selected)) {
+                    dbg.selectedEntityId = e.id;
+                }
+            }
+        }
+    }
+    ImGui::EndChild();
+
+    DebugState::EntityDebugRow s;
+    if (source && source->FindEntity(dbg.selectedEntityId, s)) {
+        ImGui::Text("Selected: #%u (gen %u)", s.slot, s.generation);
+        ImGui::Text("pos: (%.1f, %.1f)  r: %.1f", s.x, s.y, s.radius);
+        if (s.type == 1) ImGui::Text("ai: %s", s.ai ? "Seek" : "Idle");
+    }
+    else {
+        ImGui::Text("Selected: none");
+    }
+}
+
 bool DebugUI::Init(SdlPlatform& platform) {
     if (m_initialized) return true;
 
     IMGUI_CHECKVERSION();
+#if defined(MINI_ENGINE_TRACK_ALLOCS) && MINI_ENGINE_TRACK_ALLOCS
+    ImGui::SetAllocatorFunctions(&ImGuiTrackedAlloc, &ImGuiTrackedFree);
+#endif
     ImGui::CreateContext();
 
     ImGuiIO& io = ImGui::GetIO();
@@ -47,48 +145,141 @@ void DebugUI::Shutdown() {
     m_initialized = false;
 }
 
-void DebugUI::BeginFrame() {
-    if (!m_initialized || !m_enabled) return;
+void DebugUI::BeginFrame(DebugState& dbg) {
+    const bool wasVisible = m_visible;
+    m_visible = m_initialized && m_enabled && dbg.showUI;
+    m_building = false;
+
+    if (!m_visible) {
+        // Hidden overlay never captures input (Tab still reaches the game).
+        dbg.imguiWantsKeyboard = false;
+        dbg.imguiWantsMouse = false;
+        m_hasDrawData = false;
+        return;
+    }
+
+    const int interval = (dbg.uiRefreshInterval > 1) ? dbg.uiRefreshInterval : 1;
+    if (wasVisible && m_hasDrawData && ++m_framesSinceBuild < interval) {
+        return;     // replay last frame's draw data in EndFrame
+    }
+    m_framesSinceBuild = 0;
+
+    if (!wasVisible) {
+        // Key/button releases that arrived while hidden were never fed in.
+        ImGuiIO& io = ImGui::GetIO();
+        io.ClearInputKeys();
+        io.ClearInputMouse();
+    }
 
     ImGui_ImplSDLRenderer2_NewFrame();
     ImGui_ImplSDL2_NewFrame();
     ImGui::NewFrame();
+    m_building = true;
+
+    ImGuiIO& io = ImGui::GetIO();
+    dbg.imguiWantsKeyboard = io.WantCaptureKeyboard;
+    dbg.imguiWantsMouse = io.WantCaptureMouse;
 }
 
 void DebugUI::EndFrame(SdlPlatform& platform) {
-    if (!m_initialized || !m_enabled) return;
+    if (!m_visible) return;
 
-    ImGui::Render();
-    ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), platform.RendererRaw());
+    if (m_building) {
+        ImGui::Render();
+        m_hasDrawData = true;
+    }
+    // Draw data stays valid until the next NewFrame, so replays are free of UI work.
+    if (m_hasDrawData) {
+        ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), platform.RendererRaw());
+    }
 }
 
 void DebugUI::OnSdlEvent(void* userData, const void* sdlEvent) {
     DebugUI* self = reinterpret_cast<DebugUI*>(userData);
     if (!self || !self->m_initialized || !self->m_enabled) return;
+    // Events queue up inside ImGui until the next NewFrame; don't feed it
+    // while hidden or the queue would grow without bound.
+    if (!self->m_visible) return;
 
     const SDL_Event* e = reinterpret_cast<const SDL_Event*>(sdlEvent);
     ImGui_ImplSDL2_ProcessEvent(e);
 }
 
 void DebugUI::Draw(DebugState& dbg) {
-    ImGuiIO& io = ImGui::GetIO();
-    dbg.imguiWantsKeyboard = io.WantCaptureKeyboard;
-    dbg.imguiWantsMouse = io.WantCaptureMouse;
-
-    if (!m_initialized || !m_enabled) return;
-    if (!dbg.showUI) return;
+    if (!m_building) return;
 
     ImGui::Begin("Mini Engine Debug");
 
     ImGui::Text("Performance");
     ImGui::Text("dt: %.4f", dbg.dt);
     ImGui::Text("fps: %.1f", dbg.fps);
+    ImGui::Text("tick: %.0f Hz, substeps %d / %d", dbg.tickRate, dbg.substeps, dbg.maxSubsteps);
+    ImGui::Text("update: %.3f ms (budget %.2f ms)", dbg.updateMs, dbg.updateBudgetMs);
+    ImGui::Text("dilation: %.2fx  dropped: %.2f s", dbg.timeDilation, dbg.droppedSeconds);
+    ImGui::SliderInt("UI refresh (frames)", &dbg.uiRefreshInterval, 1, 10);
+    ImGui::Text("scene: %dx%d @ %.0f%%  %.2f ms", dbg.renderW, dbg.renderH, dbg.renderScale * 100.0f, dbg.sceneMs);
+    DrawFrameTimes(dbg);
+    if (dbg.aiRepathScale > 1.0f) {
+        ImGui::TextColored(ImVec4(1, 0.8f, 0.3f, 1), "AI throttled: repath x%.0f", dbg.aiRepathScale);
+    }
+    if (dbg.deterministic) {
+        ImGui::Text("deterministic: state %016llx", (unsigned long long)dbg.stateHash);
+    }
+    ImGui::Text("arena: %.1f KB  peak %.1f / %.0f KB",
+        dbg.arenaUsedBytes / 1024.0f, dbg.arenaHighWaterBytes / 1024.0f, dbg.arenaCapacityBytes / 1024.0f);
+    if (dbg.arenaOverflows > 0) {
+        ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "arena overflows: %d (heap fallback)", dbg.arenaOverflows);
+    }
     ImGui::Separator();
 
     ImGui::Text("World");
     ImGui::Text("player: (%.1f, %.1f)", dbg.playerPos.x, dbg.playerPos.y);
     ImGui::Text("camera: (%.1f, %.1f)", dbg.cameraPos.x, dbg.cameraPos.y);
     ImGui::Text("entities: %d", dbg.entityCount);
+    ImGui::Text("AI ticked: %d  deferred: %d", dbg.aiTicked, dbg.aiSkipped);
+    ImGui::Checkbox("AI LOD", &dbg.aiLodEnabled);
+    ImGui::SliderInt("AI LOD interval", &dbg.aiLodInterval, 1, 16);
+
+    if (ImGui::CollapsingHeader("Counters")) {
+        if (ImGui::BeginTable("counters", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+            ImGui::TableSetupColumn("counter");
+            ImGui::TableSetupColumn("last frame");
+            ImGui::TableSetupColumn("max");
+            ImGui::TableHeadersRow();
+            for (const Counter* c = Counters::First(); c; c = c->Next()) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(c->Name());
+                ImGui::TableNextColumn(); ImGui::Text("%lld", (long long)c->LastFrame());
+                ImGui::TableNextColumn(); ImGui::Text("%lld", (long long)c->MaxFrame());
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    if (AllocTracker::Enabled() && ImGui::CollapsingHeader("Heap")) {
+        AllocStats stats;
+        AllocTracker::GetStats(stats);
+
+        if (ImGui::BeginTable("heap", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+            ImGui::TableSetupColumn("tag");
+            ImGui::TableSetupColumn("live KB");
+            ImGui::TableSetupColumn("peak KB");
+            ImGui::TableSetupColumn("allocs/frame");
+            ImGui::TableHeadersRow();
+
+            auto row = [](const char* name, const AllocTagStats& s) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(name);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", s.liveBytes / 1024.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", s.peakBytes / 1024.0);
+                ImGui::TableNextColumn(); ImGui::Text("%llu (max %llu)",
+                    (unsigned long long)s.frameAllocs, (unsigned long long)s.maxFrameAllocs);
+            };
+            for (int i = 0; i < (int)AllocTag::Count; ++i) row(AllocTagName((AllocTag)i), stats.tags[i]);
+            row("total", stats.total);
+            ImGui::EndTable();
+        }
+    }
 
 
 ImGui::Separator();
@@ -118,24 +309,8 @@ ImGui::SliderFloat("Hit Knockback", &dbg.hitKnockback, 0.0f, 800.0f, "%.0f");
 
     ImGui::End();
 
-    ImGui::Begin("Entities");
-
-    for (int i = 0; i < dbg.debugEntityCount; ++i) {
-        const auto& e = dbg.debugEntities[i];
-
-        char label[64];
-        std::snprintf(label, sizeof(label), "%s #%u",
-            (e.type == 0) ? "Player" : "Enemy",
-            e.id);
-
-        bool selected = (dbg.selectedEntityId == e.id);
-        if (ImGui::Selectable(label, selected)) {
-            dbg.selectedEntityId = e.id;
-        }
+    if (ImGui::Begin("Entities")) {
+        DrawEntityInspector(dbg);
     }
-
-    ImGui::Separator();
-    ImGui::Text("Selected: %u", dbg.selectedEntityId);
-
     ImGui::End();
-}
\ No newline at end of file
+}
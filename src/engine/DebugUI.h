@@ -6,13 +6,18 @@ class SdlPlatform;
 /**
  * DebugUI wraps Dear ImGui lifecycle so the app/game doesn't need to know
  * backend details (SDL2 + SDL_Renderer).
+ *
+ * While dbg.showUI is false nothing ImGui-related runs (no NewFrame, Render
+ * or event processing). While shown, a new ImGui frame is built every
+ * dbg.uiRefreshInterval frames and the last draw data is replayed between.
  */
 class DebugUI {
 public:
     bool Init(SdlPlatform& platform);
     void Shutdown();
 
-    void BeginFrame();
+    // Decides whether this frame builds, replays or skips the overlay.
+    void BeginFrame(DebugState& dbg);
     void EndFrame(SdlPlatform& platform);
 
     bool Enabled() const { return m_enabled; }
@@ -26,4 +31,9 @@ public:
 private:
     bool m_enabled = true;
     bool m_initialized = false;
+
+    bool m_visible = false;         // overlay shown this frame
+    bool m_building = false;        // NewFrame() was called this frame
+    bool m_hasDrawData = false;     // a rendered frame exists to replay
+    int m_framesSinceBuild = 0;
 };
@@ -0,0 +1,37 @@
+#include "engine/FrameArena.h"
+
+void LinearArena::Init(size_t capacity) {
+    m_buffer.reset(capacity > 0 ? new std::byte[capacity] : nullptr);
+    m_capacity = capacity;
+    m_offset = 0;
+    m_highWater = 0;
+    m_overflows = 0;
+}
+
+void LinearArena::Reserve(size_t capacity) {
+    if (capacity <= m_capacity) return;
+    m_buffer.reset(new std::byte[capacity]);
+    m_capacity = capacity;
+    m_offset = 0;
+}
+
+void* LinearArena::Allocate(size_t size, size_t align) {
+    // Align the absolute address, not just the offset.
+    const uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer.get());
+    const uintptr_t cur = base + m_offset;
+    const uintptr_t aligned = (cur + (align - 1)) & ~(uintptr_t)(align - 1);
+    const size_t newOffset = (size_t)(aligned - base) + size;
+
+    if (!m_buffer || newOffset > m_capacity) {
+        m_overflows++;
+        return nullptr;
+    }
+
+    m_offset = newOffset;
+    if (m_offset > m_highWater) m_highWater = m_offset;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void LinearArena::Reset() {
+    m_offset = 0;
+}
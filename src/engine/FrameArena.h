@@ -0,0 +1,134 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * Fixed-capacity linear (bump) allocator for per-tick transient data.
+ *
+ * Allocate() just advances an offset; nothing is freed individually. Reset()
+ * drops everything at once and records the high-water mark. When the arena
+ * is full Allocate() returns nullptr and counts an overflow, and
+ * ArenaAllocator falls back to the heap, so running out of room costs a
+ * malloc instead of crashing.
+ *
+ * Mark()/Rewind() (or an ArenaScope) release everything allocated after the
+ * mark, so scratch-heavy calls can run back to back without piling up.
+ */
+class LinearArena {
+public:
+    LinearArena() = default;
+    explicit LinearArena(size_t capacity) { Init(capacity); }
+
+    void Init(size_t capacity);
+
+    // Grows the buffer to at least capacity. Drops the current contents but
+    // keeps the high-water mark and overflow count.
+    void Reserve(size_t capacity);
+
+    void* Allocate(size_t size, size_t align);
+    void Reset();
+
+    size_t Mark() const { return m_offset; }
+    void Rewind(size_t mark) { if (mark < m_offset) m_offset = mark; }
+
+    bool Owns(const void* p) const {
+        const std::byte* b = static_cast<const std::byte*>(p);
+        return b >= m_buffer.get() && b < m_buffer.get() + m_capacity;
+    }
+
+    size_t Used() const { return m_offset; }
+    size_t Capacity() const { return m_capacity; }
+    size_t HighWater() const { return m_highWater; }
+    size_t Overflows() const { return m_overflows; }
+
+private:
+    std::unique_ptr<std::byte[]> m_buffer;
+    size_t m_capacity = 0;
+    size_t m_offset = 0;
+    size_t m_highWater = 0;
+    size_t m_overflows = 0;
+};
+
+// Rewinds the arena to where it was on construction.
+class ArenaScope {
+public:
+    explicit ArenaScope(LinearArena& arena) : m_arena(arena), m_mark(arena.Mark()) {}
+    ~ArenaScope() { m_arena.Rewind(m_mark); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    LinearArena& m_arena;
+    size_t m_mark;
+};
+
+/**
+ * Two linear arenas used alternately: data allocated during tick N stays
+ * readable through tick N+1, then its arena is reset and reused.
+ */
+class DoubleBufferedArena {
+public:
+    void Init(size_t capacityEach) {
+        m_arenas[0].Init(capacityEach);
+        m_arenas[1].Init(capacityEach);
+    }
+
+    // Call once per tick: makes the older arena current and resets it,
+    // growing it to at least minCapacity first. Only the arena being reset
+    // grows, so the previous tick's data stays put; the other one catches up
+    // on the next Swap.
+    void Swap(size_t minCapacity = 0) {
+        m_current ^= 1;
+        m_arenas[m_current].Reserve(minCapacity);
+        m_arenas[m_current].Reset();
+    }
+
+    LinearArena& Current() { return m_arenas[m_current]; }
+    const LinearArena& Previous() const { return m_arenas[m_current ^ 1]; }
+
+private:
+    LinearArena m_arenas[2];
+    int m_current = 0;
+};
+
+/**
+ * STL allocator over a LinearArena. deallocate() is a no-op for arena memory
+ * (reclaimed on Reset); overflow allocations go to the heap and are freed
+ * normally. Containers using it must not outlive the arena's next Reset().
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(LinearArena& arena) noexcept : m_arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& o) noexcept : m_arena(o.Arena()) {}
+
+    T* allocate(size_t n) {
+        if (void* p = m_arena->Allocate(n * sizeof(T), alignof(T)))
+            return static_cast<T*>(p);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        if (!m_arena->Owns(p)) ::operator delete(p);
+    }
+
+    LinearArena* Arena() const noexcept { return m_arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& o) const noexcept { return m_arena == o.Arena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& o) const noexcept { return m_arena != o.Arena(); }
+
+private:
+    LinearArena* m_arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,76 @@
+#include "engine/FrameStats.h"
+
+#include <algorithm>
+#include <cstdio>
+
+void FrameTimeHistory::Push(float ms) {
+    if (ms < 0.0f) ms = 0.0f;
+
+    m_last = ms;
+    m_window[m_next] = ms;
+    m_next = (m_next + 1) % kWindow;
+    if (m_count < kWindow) ++m_count;
+
+    const int bucket = std::min(kBuckets, (int)(ms / kBucketMs));
+    m_histogram[bucket]++;
+    m_total++;
+    m_sumMs += ms;
+    m_maxMs = std::max(m_maxMs, ms);
+    if (m_budgetMs > 0.0f && ms > m_budgetMs) m_overBudget++;
+}
+
+FrameTimeSummary FrameTimeHistory::SummarizeWindow(float budgetMs) const {
+    FrameTimeSummary s;
+    s.samples = m_count;
+    if (m_count == 0) return s;
+
+    float sorted[kWindow];
+    std::copy(m_window, m_window + m_count, sorted);
+    std::sort(sorted, sorted + m_count);
+
+    auto pct = [&](float p) { return sorted[std::min(m_count - 1, (int)(p * (float)m_count))]; };
+    s.p50 = pct(0.50f);
+    s.p95 = pct(0.95f);
+    s.p99 = pct(0.99f);
+    s.max = sorted[m_count - 1];
+
+    double sum = 0.0;
+    for (int i = 0; i < m_count; ++i) {
+        sum += sorted[i];
+        if (sorted[i] > budgetMs) s.hitches++;
+    }
+    s.avg = (float)(sum / m_count);
+    return s;
+}
+
+FrameTimeSummary FrameTimeHistory::SummarizeLifetime() const {
+    FrameTimeSummary s;
+    s.samples = (int)m_total;
+    if (m_total == 0) return s;
+
+    // Percentiles report the upper edge of the bucket (0.1 ms resolution).
+    const uint64_t r50 = (uint64_t)(m_total * 0.50);
+    const uint64_t r95 = (uint64_t)(m_total * 0.95);
+    const uint64_t r99 = (uint64_t)(m_total * 0.99);
+
+    uint64_t seen = 0;
+    for (int b = 0; b <= kBuckets; ++b) {
+        const uint64_t before = seen;
+        seen += m_histogram[b];
+        const float edge = (b < kBuckets) ? (float)(b + 1) * kBucketMs : m_maxMs;
+        if (before <= r50 && r50 < seen) s.p50 = edge;
+        if (before <= r95 && r95 < seen) s.p95 = edge;
+        if (before <= r99 && r99 < seen) s.p99 = edge;
+    }
+    s.hitches = (int)m_overBudget;
+
+    s.avg = (float)(m_sumMs / (double)m_total);
+    s.max = m_maxMs;
+    return s;
+}
+
+void FrameTimeHistory::Print(const char* label) const {
+    const FrameTimeSummary s = SummarizeLifetime();
+    std::printf("[STATS] %-8s n=%d avg=%.2f p50=%.1f p95=%.1f p99=%.1f max=%.2f ms, over %.2f ms: %d\n",
+        label, s.samples, s.avg, s.p50, s.p95, s.p99, s.max, m_budgetMs, s.hitches);
+}
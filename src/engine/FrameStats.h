@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+
+struct FrameTimeSummary {
+    int samples = 0;
+    float avg = 0.0f;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+    int hitches = 0;    // samples over budget
+};
+
+/**
+ * Frame-time history for one stage (update / render / present / frame).
+ *
+ * Keeps a rolling window of recent samples (for plots and live percentiles)
+ * plus a lifetime histogram with 0.1 ms buckets, so whole-run percentiles
+ * can be reported at exit without storing every sample.
+ */
+class FrameTimeHistory {
+public:
+    static constexpr int kWindow = 240;             // ~4 s at 60 Hz
+    static constexpr int kBuckets = 1000;           // 0..100 ms
+    static constexpr float kBucketMs = 0.1f;
+
+    // Samples strictly over the budget are counted exactly as they are
+    // pushed (the histogram alone can't split the bucket holding the budget).
+    // Set it before pushing; 0 = no budget.
+    void SetBudget(float budgetMs) { m_budgetMs = budgetMs; }
+    float Budget() const { return m_budgetMs; }
+
+    void Push(float ms);
+
+    // Rolling window, oldest first from Offset() (ImGui::PlotLines layout).
+    const float* Window() const { return m_window; }
+    int WindowCount() const { return m_count; }
+    int WindowOffset() const { return (m_count < kWindow) ? 0 : m_next; }
+
+    FrameTimeSummary SummarizeWindow(float budgetMs) const;
+    // Hitches are over the SetBudget() budget.
+    FrameTimeSummary SummarizeLifetime() const;
+
+    const uint32_t* Histogram() const { return m_histogram; }
+    float Last() const { return m_last; }
+
+    // One line, e.g. for CI logs at exit.
+    void Print(const char* label) const;
+
+private:
+    float m_window[kWindow] = {};
+    int m_next = 0;
+    int m_count = 0;
+    float m_last = 0.0f;
+
+    uint32_t m_histogram[kBuckets + 1] = {};        // last bucket = overflow
+    uint64_t m_total = 0;
+    double m_sumMs = 0.0;
+    float m_maxMs = 0.0f;
+    float m_budgetMs = 0.0f;
+    uint64_t m_overBudget = 0;
+};
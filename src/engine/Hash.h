@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Small, stable hashes (same result on every platform and build).
+ */
+constexpr uint64_t kHashSeed = 0xCBF29CE484222325ull;  // FNV-1a offset basis
+
+// FNV-1a 64 over raw bytes; chain calls by passing the previous result.
+inline uint64_t HashBytes(const void* data, size_t size, uint64_t h = kHashSeed) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+// Integer mixer (lowbias32) for cheap per-tick noise.
+inline uint32_t HashU32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
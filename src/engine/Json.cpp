@@ -0,0 +1,153 @@
+#include "engine/Json.h"
+
+#include <charconv>
+
+namespace {
+
+    constexpr int kMaxDepth = 64;
+
+    class JsonReader {
+    public:
+        JsonReader(std::string_view text, JsonSaxHandler& handler)
+            : m_p(text.data()), m_begin(text.data()), m_end(text.data() + text.size()), m_handler(handler) {}
+
+        bool Parse() {
+            SkipWs();
+            if (!ParseValue(0)) return false;
+            SkipWs();
+            if (m_p != m_end) return Fail("trailing characters");
+            return true;
+        }
+
+        JsonError Error() const { return m_error; }
+
+    private:
+        bool Fail(const char* msg) {
+            if (!m_error.message) {
+                m_error.offset = (size_t)(m_p - m_begin);
+                m_error.message = msg;
+            }
+            return false;
+        }
+
+        void SkipWs() {
+            while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\n' || *m_p == '\r'))
+                ++m_p;
+        }
+
+        bool Consume(char c) {
+            SkipWs();
+            if (m_p < m_end && *m_p == c) { ++m_p; return true; }
+            return false;
+        }
+
+        bool Literal(std::string_view lit) {
+            if ((size_t)(m_end - m_p) < lit.size() || std::string_view(m_p, lit.size()) != lit)
+                return Fail("invalid literal");
+            m_p += lit.size();
+            return true;
+        }
+
+        bool ParseString(std::string_view& out) {
+            // Assumes *m_p == '"'
+            const char* start = ++m_p;
+            while (m_p < m_end && *m_p != '"') {
+                if (*m_p == '\\') {
+                    ++m_p;              // skip escaped char (left raw in the view)
+                    if (m_p >= m_end) break;
+                }
+                ++m_p;
+            }
+            if (m_p >= m_end) return Fail("unterminated string");
+            out = std::string_view(start, (size_t)(m_p - start));
+            ++m_p; // closing quote
+            return true;
+        }
+
+        bool ParseNumber() {
+            // JSON numbers start with '-' or a digit (from_chars would also take inf/nan).
+            double v = 0.0;
+            auto res = std::from_chars(m_p, m_end, v);
+            if (res.ec != std::errc()) return Fail("invalid number");
+            m_p = res.ptr;
+            return m_handler.OnNumber(v) || Fail("aborted");
+        }
+
+        bool ParseObject(int depth) {
+            ++m_p; // '{'
+            if (!m_handler.OnBeginObject()) return Fail("aborted");
+
+            if (Consume('}'))
+                return m_handler.OnEndObject() || Fail("aborted");
+
+            while (true) {
+                SkipWs();
+                if (m_p >= m_end || *m_p != '"') return Fail("expected key");
+
+                std::string_view key;
+                if (!ParseString(key)) return false;
+                if (!m_handler.OnKey(key)) return Fail("aborted");
+
+                if (!Consume(':')) return Fail("expected ':'");
+                SkipWs();
+                if (!ParseValue(depth + 1)) return false;
+
+                if (Consume(',')) continue;
+                if (Consume('}')) break;
+                return Fail("expected ',' or '}'");
+            }
+            return m_handler.OnEndObject() || Fail("aborted");
+        }
+
+        bool ParseArray(int depth) {
+            ++m_p; // '['
+            if (!m_handler.OnBeginArray()) return Fail("aborted");
+
+            if (Consume(']'))
+                return m_handler.OnEndArray() || Fail("aborted");
+
+            while (true) {
+                SkipWs();
+                if (!ParseValue(depth + 1)) return false;
+
+                if (Consume(',')) continue;
+                if (Consume(']')) break;
+                return Fail("expected ',' or ']'");
+            }
+            return m_handler.OnEndArray() || Fail("aborted");
+        }
+
+        bool ParseValue(int depth) {
+            if (depth > kMaxDepth) return Fail("nesting too deep");
+            if (m_p >= m_end) return Fail("unexpected end of input");
+
+            const char c = *m_p;
+            if (c == '{') return ParseObject(depth);
+            if (c == '[') return ParseArray(depth);
+            if (c == '"') {
+                std::string_view s;
+                if (!ParseString(s)) return false;
+                return m_handler.OnString(s) || Fail("aborted");
+            }
+            if (c == '-' || (c >= '0' && c <= '9')) return ParseNumber();
+            if (c == 't') return Literal("true") && (m_handler.OnBool(true) || Fail("aborted"));
+            if (c == 'f') return Literal("false") && (m_handler.OnBool(false) || Fail("aborted"));
+            if (c == 'n') return Literal("null") && (m_handler.OnNull() || Fail("aborted"));
+            return Fail("unexpected character");
+        }
+
+        const char* m_p;
+        const char* m_begin;
+        const char* m_end;
+        JsonSaxHandler& m_handler;
+        JsonError m_error{};
+    };
+
+} // namespace
+
+bool ParseJson(std::string_view text, JsonSaxHandler& handler, JsonError* outError) {
+    JsonReader reader(text, handler);
+    const bool ok = reader.Parse();
+    if (!ok && outError) *outError = reader.Error();
+    return ok;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+/**
+ * Minimal single-pass SAX-style JSON reader.
+ *
+ * The parser never allocates: strings/keys are handed out as views into the
+ * source text (escape sequences are left as-is, which is fine for config
+ * keys) and numbers are parsed with std::from_chars.
+ *
+ * Any callback may return false to abort the parse.
+ */
+class JsonSaxHandler {
+public:
+    virtual ~JsonSaxHandler() = default;
+
+    virtual bool OnBeginObject() { return true; }
+    virtual bool OnEndObject() { return true; }
+    virtual bool OnBeginArray() { return true; }
+    virtual bool OnEndArray() { return true; }
+    virtual bool OnKey(std::string_view key) { (void)key; return true; }
+    virtual bool OnNumber(double v) { (void)v; return true; }
+    virtual bool OnString(std::string_view v) { (void)v; return true; }
+    virtual bool OnBool(bool v) { (void)v; return true; }
+    virtual bool OnNull() { return true; }
+};
+
+struct JsonError {
+    size_t offset = 0;
+    const char* message = nullptr;
+};
+
+// Returns false on malformed input (or if a handler aborted).
+bool ParseJson(std::string_view text, JsonSaxHandler& handler, JsonError* outError = nullptr);
@@ -0,0 +1,188 @@
+#include "engine/Log.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <thread>
+
+namespace {
+    constexpr uint64_t kSlots = 1024;          // power of two
+    constexpr size_t kMaxMessage = 240;
+
+    struct Slot {
+        std::atomic<uint64_t> seq{ 0 };
+        uint64_t timeNs = 0;
+        LogLevel level = LogLevel::Info;
+        LogCategory category = LogCategory::Core;
+        char text[kMaxMessage] = {};
+    };
+
+    const char* kLevelNames[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "OFF" };
+    const char* kCategoryNames[(int)LogCategory::Count] = {
+        "core", "platform", "assets", "hotreload", "config", "game"
+    };
+
+    // Bounded MPSC queue (Vyukov): each slot's seq says whose turn it is.
+    Slot g_slots[kSlots];
+    std::atomic<uint64_t> g_enqueuePos{ 0 };
+    uint64_t g_dequeuePos = 0;                  // writer thread only
+    std::atomic<bool> g_ringReady{ false };
+    std::atomic<int> g_producers{ 0 };          // Write() calls in progress
+
+    std::atomic<int> g_minLevel{ (int)LogLevel::Trace };
+    std::atomic<uint64_t> g_dropped{ 0 };
+    std::atomic<bool> g_running{ false };
+    std::thread g_writer;
+    FILE* g_out = nullptr;
+
+    const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+    uint64_t NowNs() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - g_epoch).count();
+    }
+
+    void WriteLine(FILE* out, uint64_t timeNs, LogLevel level, LogCategory category, const char* text) {
+        std::fprintf(out, "[%9.3f] [%s] [%s] %s\n", timeNs / 1e9,
+            kLevelNames[(int)level], kCategoryNames[(int)category], text);
+    }
+
+    // Writer thread: returns how many messages were written.
+    int Drain() {
+        int n = 0;
+        while (true) {
+            Slot& s = g_slots[g_dequeuePos & (kSlots - 1)];
+            if (s.seq.load(std::memory_order_acquire) != g_dequeuePos + 1) break;
+
+            WriteLine(g_out, s.timeNs, s.level, s.category, s.text);
+            s.seq.store(g_dequeuePos + kSlots, std::memory_order_release);
+            ++g_dequeuePos;
+            ++n;
+        }
+        if (n > 0) std::fflush(g_out);
+        return n;
+    }
+
+    // Held for the whole of Write() so Stop() can wait out writers that
+    // saw the ring as ready just before it was closed.
+    struct ProducerScope {
+        ProducerScope() { g_producers.fetch_add(1); }
+        ~ProducerScope() { g_producers.fetch_sub(1, std::memory_order_release); }
+    };
+
+    void WriterMain() {
+        while (g_running.load(std::memory_order_acquire)) {
+            if (Drain() == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+        Drain();
+    }
+}
+
+namespace Log {
+    bool Start(const char* filePath) {
+        if (g_running.load()) return true;
+
+        g_out = stdout;
+        if (filePath) {
+            g_out = std::fopen(filePath, "w");
+            if (!g_out) {
+                g_out = stdout;
+                std::printf("[WARN] Could not open log file %s, using stdout\n", filePath);
+            }
+        }
+
+        for (uint64_t i = 0; i < kSlots; ++i) g_slots[i].seq.store(i, std::memory_order_relaxed);
+        g_enqueuePos.store(0, std::memory_order_relaxed);
+        g_dequeuePos = 0;
+        g_ringReady.store(true, std::memory_order_release);
+
+        g_running.store(true, std::memory_order_release);
+        g_writer = std::thread(WriterMain);
+        return true;
+    }
+
+    void Stop() {
+        if (!g_running.load()) return;
+
+        // Close the ring first so new messages go out synchronously, wait for
+        // writes already in flight to publish, then let the writer drain the rest.
+        g_ringReady.store(false);
+        while (g_producers.load() > 0) std::this_thread::yield();
+
+        g_running.store(false, std::memory_order_release);
+        if (g_writer.joinable()) g_writer.join();
+
+        if (g_dropped.load() > 0) {
+            std::fprintf(g_out, "[WARN] [core] %llu log messages dropped (ring full)\n",
+                (unsigned long long)g_dropped.load());
+        }
+        if (g_out && g_out != stdout) std::fclose(g_out);
+        g_out = nullptr;
+    }
+
+    void SetLevel(LogLevel level) { g_minLevel.store((int)level, std::memory_order_relaxed); }
+
+    bool ShouldLog(LogLevel level) { return (int)level >= g_minLevel.load(std::memory_order_relaxed); }
+
+    void Write(LogLevel level, LogCategory category, const char* fmt, ...) {
+        ProducerScope producer;
+        va_list args;
+        va_start(args, fmt);
+
+        // seq_cst, paired with Stop(): either Stop sees this producer or we see the ring closed.
+        if (!g_ringReady.load()) {
+            // No writer yet: plain synchronous output.
+            char text[kMaxMessage];
+            std::vsnprintf(text, sizeof(text), fmt, args);
+            va_end(args);
+            WriteLine(stdout, NowNs(), level, category, text);
+            return;
+        }
+
+        uint64_t pos = g_enqueuePos.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &g_slots[pos & (kSlots - 1)];
+            const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+            const int64_t diff = (int64_t)seq - (int64_t)pos;
+            if (diff == 0) {
+                if (g_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                // Full: never wait for the writer.
+                g_dropped.fetch_add(1, std::memory_order_relaxed);
+                va_end(args);
+                return;
+            }
+            else {
+                pos = g_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->timeNs = NowNs();
+        slot->level = level;
+        slot->category = category;
+        std::vsnprintf(slot->text, sizeof(slot->text), fmt, args);
+        va_end(args);
+
+        slot->seq.store(pos + 1, std::memory_order_release);
+    }
+
+    uint64_t Dropped() { return g_dropped.load(std::memory_order_relaxed); }
+
+    RateLimit::RateLimit(float intervalSeconds)
+        : m_intervalNs((uint64_t)((double)intervalSeconds * 1e9)) {}
+
+    bool RateLimit::Allow(uint32_t& suppressed) {
+        const uint64_t now = NowNs();
+        uint64_t next = m_nextNs.load(std::memory_order_relaxed);
+        if (now < next || !m_nextNs.compare_exchange_strong(next, now + m_intervalNs, std::memory_order_relaxed)) {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+}
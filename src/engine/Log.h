@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Leveled, categorized logging that never blocks the caller on I/O.
+ *
+ * Messages are formatted on the calling thread into a fixed MPSC ring and
+ * written by a background thread (Log::Start). If the ring is full the
+ * message is dropped and counted. Before Start (tools, tests) messages are
+ * written synchronously.
+ *
+ * MINI_ENGINE_LOG_LEVEL removes levels below it at compile time: the
+ * arguments of a filtered-out LOG_* are never evaluated.
+ */
+enum class LogLevel : uint8_t { Trace, Debug, Info, Warn, Error, Off };
+
+enum class LogCategory : uint8_t {
+    Core,
+    Platform,
+    Assets,
+    HotReload,
+    Config,
+    Game,
+    Count
+};
+
+#ifndef MINI_ENGINE_LOG_LEVEL
+#define MINI_ENGINE_LOG_LEVEL 1     // LogLevel::Debug
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_PRINTF_FORMAT(fmtIndex, argIndex) __attribute__((format(printf, fmtIndex, argIndex)))
+#else
+#define LOG_PRINTF_FORMAT(fmtIndex, argIndex)
+#endif
+
+namespace Log {
+    // Background writer to stdout, or to filePath when given.
+    bool Start(const char* filePath = nullptr);
+    // Drains everything queued, then joins the writer.
+    void Stop();
+
+    // Runtime filter on top of the compile-time one.
+    void SetLevel(LogLevel level);
+    bool ShouldLog(LogLevel level);
+
+    void Write(LogLevel level, LogCategory category, const char* fmt, ...) LOG_PRINTF_FORMAT(3, 4);
+
+    uint64_t Dropped();     // lost because the ring was full
+
+    // Per-call-site limiter used by LOG_EVERY.
+    class RateLimit {
+    public:
+        explicit RateLimit(float intervalSeconds);
+
+        // True if the caller may log now; suppressed = messages skipped since
+        // the last allowed one.
+        bool Allow(uint32_t& suppressed);
+
+    private:
+        uint64_t m_intervalNs;
+        std::atomic<uint64_t> m_nextNs{ 0 };
+        std::atomic<uint32_t> m_suppressed{ 0 };
+    };
+}
+
+#define LOG_AT(level, category, ...)                                            \
+    do {                                                                        \
+        if constexpr ((int)(level) >= MINI_ENGINE_LOG_LEVEL) {                  \
+            if (Log::ShouldLog(level)) Log::Write(level, category, __VA_ARGS__);\
+        }                                                                       \
+    } while (0)
+
+#define LOG_TRACE(category, ...) LOG_AT(LogLevel::Trace, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) LOG_AT(LogLevel::Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...)  LOG_AT(LogLevel::Info, category, __VA_ARGS__)
+#define LOG_WARN(category, ...)  LOG_AT(LogLevel::Warn, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) LOG_AT(LogLevel::Error, category, __VA_ARGS__)
+
+// At most one message per `seconds` from this call site.
+#define LOG_EVERY(seconds, level, category, ...)                                \
+    do {                                                                        \
+        if constexpr ((int)(level) >= MINI_ENGINE_LOG_LEVEL) {                  \
+            static Log::RateLimit logRateLimit_(seconds);                       \
+            uint32_t logSuppressed_ = 0;                                        \
+            if (Log::ShouldLog(level) && logRateLimit_.Allow(logSuppressed_)) { \
+                Log::Write(level, category, __VA_ARGS__);                       \
+                if (logSuppressed_ > 0)                                         \
+                    Log::Write(level, category, "(%u similar suppressed)", logSuppressed_); \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
@@ -11,3 +11,13 @@ struct Vec2 {
     Vec2 operator-(const Vec2& o) const { return { x - o.x, y - o.y }; }
     Vec2 operator*(float s) const { return { x * s, y * s }; }
 };
+
+// Axis-aligned box, bounds inclusive.
+struct Aabb {
+    Vec2 min;
+    Vec2 max;
+
+    bool Contains(const Vec2& p) const {
+        return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+    }
+};
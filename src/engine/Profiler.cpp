@@ -0,0 +1,77 @@
+#include "engine/Profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+namespace {
+    struct ZoneEvent {
+        const char* name;
+        uint64_t startNs;
+        uint64_t endNs;
+        uint32_t tid;
+    };
+
+    // ~1.5 MB; roughly a minute of history at the current zone density.
+    constexpr uint64_t kCapacity = 1u << 16;
+
+    std::unique_ptr<ZoneEvent[]> g_events(new ZoneEvent[kCapacity]);
+    std::atomic<uint64_t> g_head{ 0 };
+    std::atomic<bool> g_enabled{ true };
+    std::atomic<uint32_t> g_nextTid{ 1 };
+
+    const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+    uint32_t ThreadId() {
+        thread_local uint32_t tid = g_nextTid.fetch_add(1, std::memory_order_relaxed);
+        return tid;
+    }
+}
+
+namespace Profiler {
+    void SetEnabled(bool enabled) { g_enabled.store(enabled, std::memory_order_relaxed); }
+    bool Enabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+    uint64_t NowNs() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - g_epoch).count();
+    }
+
+    void Record(const char* name, uint64_t startNs, uint64_t endNs) {
+        const uint64_t i = g_head.fetch_add(1, std::memory_order_relaxed);
+        g_events[i & (kCapacity - 1)] = ZoneEvent{ name, startNs, endNs, ThreadId() };
+    }
+
+    bool WriteChromeTrace(const char* path, float seconds) {
+        FILE* f = std::fopen(path, "w");
+        if (!f) {
+            std::printf("[ERROR] Could not write trace: %s\n", path);
+            return false;
+        }
+
+        const uint64_t head = g_head.load(std::memory_order_acquire);
+        const uint64_t count = (head < kCapacity) ? head : kCapacity;
+        const uint64_t now = NowNs();
+        const uint64_t windowNs = (uint64_t)((double)seconds * 1e9);
+        const uint64_t cutoff = (now > windowNs) ? now - windowNs : 0;
+
+        std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        std::fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"mini_engine\"}}");
+
+        int written = 0;
+        for (uint64_t i = head - count; i < head; ++i) {
+            const ZoneEvent& e = g_events[i & (kCapacity - 1)];
+            if (!e.name || e.endNs < cutoff) continue;
+            std::fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                e.name, e.tid, e.startNs / 1000.0, (e.endNs - e.startNs) / 1000.0);
+            ++written;
+        }
+
+        std::fprintf(f, "\n]}\n");
+        std::fclose(f);
+
+        std::printf("[INFO] Trace written (%d zones, last %.0f s): %s\n", written, seconds, path);
+        return true;
+    }
+}
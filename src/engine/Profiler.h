@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Lightweight zone profiler.
+ *
+ * Zones are recorded into a fixed ring buffer (oldest events are
+ * overwritten) and can be dumped as Chrome Trace Event JSON, which opens in
+ * chrome://tracing and Perfetto. Zone names must be string literals (only the
+ * pointer is stored). Dump from the main thread; a zone finishing on another
+ * thread during a dump may be written torn.
+ */
+namespace Profiler {
+    void SetEnabled(bool enabled);
+    bool Enabled();
+
+    uint64_t NowNs();   // monotonic, relative to first use
+
+    void Record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Writes every buffered zone that ended within the last `seconds`.
+    bool WriteChromeTrace(const char* path, float seconds);
+}
+
+// Scoped zone. Next() closes the current zone and opens another, which keeps
+// long linear functions (e.g. Game::Step) readable without extra blocks.
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name)
+        : m_name(Profiler::Enabled() ? name : nullptr), m_start(m_name ? Profiler::NowNs() : 0) {}
+    ~ProfileZone() { End(); }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+    void Next(const char* name) {
+        End();
+        if (Profiler::Enabled()) {
+            m_name = name;
+            m_start = Profiler::NowNs();
+        }
+    }
+
+    void End() {
+        if (!m_name) return;
+        Profiler::Record(m_name, m_start, Profiler::NowNs());
+        m_name = nullptr;
+    }
+
+private:
+    const char* m_name;
+    uint64_t m_start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Small seeded PRNG (xorshift32) with the same sequence on every platform,
+ * unlike <random> distributions. For content generation and scripted
+ * input, not for anything security-related.
+ */
+class Rng {
+public:
+    explicit Rng(uint32_t seed = 1) { Seed(seed); }
+
+    void Seed(uint32_t seed) {
+        // Mix the seed so 0/1/2... don't produce correlated streams; never 0.
+        uint32_t s = seed * 0x9E3779B9u + 0x7F4A7C15u;
+        s ^= s >> 16;
+        m_state = (s != 0) ? s : 0x6D2B79F5u;
+    }
+
+    uint32_t Next() {
+        uint32_t x = m_state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        m_state = x;
+        return x;
+    }
+
+    // [0, n), n > 0
+    int Range(int n) { return (int)(((uint64_t)Next() * (uint64_t)n) >> 32); }
+
+    // [0, 1)
+    float Unit() { return (float)(Next() >> 8) * (1.0f / 16777216.0f); }
+
+    bool Chance(float p) { return Unit() < p; }
+
+private:
+    uint32_t m_state = 1;
+};
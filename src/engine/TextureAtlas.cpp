@@ -0,0 +1,144 @@
+#include "engine/TextureAtlas.h"
+#include "platform/SdlPlatform.h"
+
+#include <SDL.h>
+#include "engine/Log.h"
+
+// imgui_draw.cpp compiles its own static copy; keep ours private to this file too.
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+static constexpr int kPadding = 1;
+static constexpr int kMinPageSize = 256;
+
+void AtlasBuildResult::FreePages() {
+    for (SDL_Surface* s : pages) {
+        if (s) SDL_FreeSurface(s);
+    }
+    pages.clear();
+}
+
+void AtlasBuildResult::FreeSources() {
+    for (SDL_Surface* s : sources) {
+        if (s) SDL_FreeSurface(s);
+    }
+    sources.clear();
+}
+
+bool BuildAtlas(int maxPageSize, AtlasBuildResult& build) {
+    build.FreePages();
+    build.sprites.assign(build.sources.size(), AtlasSprite{});
+
+    // 1) Collect every sprite that could fit on a page (index = sprite index).
+    const std::vector<SDL_Surface*>& sources = build.sources;
+    std::vector<stbrp_rect> pending;
+    long long totalArea = 0;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        SDL_Surface* src = sources[i];
+        if (!src) continue;
+        if (src->w + kPadding > maxPageSize || src->h + kPadding > maxPageSize) {
+            LOG_WARN(LogCategory::Assets, "Sprite too large for atlas page (%s)", build.names[i].c_str());
+            continue;
+        }
+
+        // Straight copy into the page, no blending.
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        totalArea += (long long)(src->w + kPadding) * (src->h + kPadding);
+
+        stbrp_rect r{};
+        r.id = (int)i;
+        r.w = src->w + kPadding;
+        r.h = src->h + kPadding;
+        pending.push_back(r);
+    }
+    if (pending.empty()) {
+        build.FreeSources();
+        return false;
+    }
+
+    // Smallest power-of-two page that could hold everything (capped).
+    int pageSize = kMinPageSize;
+    while (pageSize < maxPageSize && (long long)pageSize * pageSize < totalArea) pageSize *= 2;
+    if (pageSize > maxPageSize) pageSize = maxPageSize;
+
+    // 2) Pack into pages until every sprite has a home.
+    std::vector<stbrp_node> nodes((size_t)pageSize);
+    while (!pending.empty()) {
+        stbrp_context ctx;
+        stbrp_init_target(&ctx, pageSize, pageSize, nodes.data(), (int)nodes.size());
+        stbrp_setup_heuristic(&ctx, STBRP_HEURISTIC_Skyline_BF_sortHeight); // tighter than the BL default
+        stbrp_pack_rects(&ctx, pending.data(), (int)pending.size());
+
+        SDL_Surface* page = SDL_CreateRGBSurfaceWithFormat(0, pageSize, pageSize, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!page) break;
+        const int pageIndex = (int)build.pages.size();
+        build.pages.push_back(page);
+
+        std::vector<stbrp_rect> next;
+        for (const stbrp_rect& r : pending) {
+            if (!r.was_packed) {
+                next.push_back(r);
+                continue;
+            }
+            SDL_Surface* src = sources[(size_t)r.id];
+            SDL_Rect dst{ r.x, r.y, src->w, src->h };
+            SDL_BlitSurface(src, nullptr, page, &dst);
+
+            AtlasSprite& sprite = build.sprites[(size_t)r.id];
+            sprite.page = pageIndex;
+            sprite.rect = AtlasRect{ r.x, r.y, src->w, src->h };
+        }
+
+        // Nothing fit on an empty page -> give up rather than loop forever.
+        if (next.size() == pending.size()) break;
+        pending.swap(next);
+    }
+
+    build.FreeSources();
+    return !build.pages.empty();
+}
+
+bool TextureAtlas::Upload(SdlPlatform& platform, AtlasBuildResult& built) {
+    // Upload into a scratch atlas so a failure keeps the current one drawable.
+    TextureAtlas next;
+    next.m_pages.resize(built.pages.size());
+    for (size_t i = 0; i < built.pages.size(); ++i) {
+        if (!next.m_pages[i].CreateFromSurface(platform, built.pages[i])) {
+            next.Destroy();
+            built.FreePages();
+            return false;
+        }
+    }
+    built.FreePages();
+
+    next.m_sprites = built.sprites;
+    for (size_t i = 0; i < built.names.size(); ++i) {
+        if (next.m_sprites[i].page >= 0) next.m_byName[built.names[i]] = (int)i;
+    }
+
+    Destroy();
+    m_pages.swap(next.m_pages);
+    m_sprites.swap(next.m_sprites);
+    m_byName.swap(next.m_byName);
+
+    LOG_INFO(LogCategory::Assets, "Atlas uploaded: %zu sprites on %zu page(s)", m_byName.size(), m_pages.size());
+    return true;
+}
+
+void TextureAtlas::Destroy() {
+    for (SdlTexture& t : m_pages) t.Destroy();
+    m_pages.clear();
+    m_sprites.clear();
+    m_byName.clear();
+}
+
+int TextureAtlas::Find(std::string_view name) const {
+    auto it = m_byName.find(std::string(name));
+    return (it == m_byName.end()) ? -1 : it->second;
+}
+
+const AtlasSprite* TextureAtlas::Sprite(int index) const {
+    if (index < 0 || index >= (int)m_sprites.size()) return nullptr;
+    return &m_sprites[(size_t)index];
+}
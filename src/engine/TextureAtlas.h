@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "platform/SdlTexture.h"
+
+struct SDL_Surface;
+class SdlPlatform;
+
+struct AtlasRect {
+    int x = 0, y = 0, w = 0, h = 0;   // pixels within the page
+};
+
+// A sprite is a page index plus its source rect on that page.
+struct AtlasSprite {
+    int page = -1;
+    AtlasRect rect;
+};
+
+/**
+ * CPU side of an atlas build: decoded sprites in, packed page surfaces out.
+ * Safe to produce on a worker thread; owns its surfaces until uploaded.
+ */
+struct AtlasBuildResult {
+    // Input: one RGBA32 surface per sprite, consumed by BuildAtlas.
+    std::vector<std::string> names;     // sprite name (file stem) per sprite
+    std::vector<SDL_Surface*> sources;
+
+    // Output
+    std::vector<SDL_Surface*> pages;
+    std::vector<AtlasSprite> sprites;
+
+    AtlasBuildResult() = default;
+    AtlasBuildResult(const AtlasBuildResult&) = delete;
+    AtlasBuildResult& operator=(const AtlasBuildResult&) = delete;
+    ~AtlasBuildResult() { FreePages(); FreeSources(); }
+
+    void FreePages();
+    void FreeSources();
+};
+
+// Packs build.sources (stb_rectpack, 1px padding) into as few pages of at most
+// maxPageSize^2 as possible, then frees them. Sprites that don't fit are skipped.
+bool BuildAtlas(int maxPageSize, AtlasBuildResult& build);
+
+/**
+ * GPU side: page textures plus a name -> sprite table.
+ * Drawing many sprites from one page keeps SDL_Renderer on a single texture.
+ */
+class TextureAtlas {
+public:
+    // Render thread: uploads the built pages and replaces the current contents.
+    // On failure the current contents are left untouched.
+    bool Upload(SdlPlatform& platform, AtlasBuildResult& built);
+    void Destroy();
+
+    // Returns a sprite index, or -1 if unknown.
+    int Find(std::string_view name) const;
+    const AtlasSprite* Sprite(int index) const;
+
+    int PageCount() const { return (int)m_pages.size(); }
+    const SdlTexture& Page(int page) const { return m_pages[(size_t)page]; }
+
+private:
+    std::vector<SdlTexture> m_pages;
+    std::vector<AtlasSprite> m_sprites;
+    std::unordered_map<std::string, int> m_byName;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Lock-free single-producer / single-consumer triple buffer.
+ *
+ * The producer always owns one slot (WriteBuffer), the consumer always owns
+ * another (ReadBuffer), and the third sits in the middle. Publish() swaps the
+ * write slot into the middle; Acquire() swaps the middle into the read slot
+ * if something new was published. Neither side ever waits on the other, and
+ * the consumer always sees the most recently completed write.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side
+    T& WriteBuffer() { return m_buffers[m_write]; }
+
+    void Publish() {
+        const std::uint8_t prev = m_middle.exchange(
+            static_cast<std::uint8_t>(m_write | kFreshBit), std::memory_order_acq_rel);
+        m_write = prev & kIndexMask;
+    }
+
+    // Consumer side. Returns true if a new buffer was picked up.
+    bool Acquire() {
+        if ((m_middle.load(std::memory_order_relaxed) & kFreshBit) == 0)
+            return false;
+
+        const std::uint8_t prev = m_middle.exchange(m_read, std::memory_order_acq_rel);
+        m_read = prev & kIndexMask;
+        return true;
+    }
+
+    const T& ReadBuffer() const { return m_buffers[m_read]; }
+
+private:
+    static constexpr std::uint8_t kIndexMask = 0x3;
+    static constexpr std::uint8_t kFreshBit = 0x4;
+
+    T m_buffers[3];
+    std::uint8_t m_write = 0;                  // producer-owned
+    std::uint8_t m_read = 1;                   // consumer-owned
+    std::atomic<std::uint8_t> m_middle{ 2 };   // index | fresh bit
+};
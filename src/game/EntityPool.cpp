@@ -0,0 +1,251 @@
+#include "game/EntityPool.h"
+#include "engine/BinaryStream.h"
+
+#include <cmath>
+#include <utility>
+
+Entity& EntityPool::Create() {
+    uint32_t slotIndex = 0;
+    if (!m_freeSlots.empty()) {
+        slotIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        slotIndex = (uint32_t)m_slots.size();
+        m_slots.push_back(Slot{});
+    }
+
+    Slot& slot = m_slots[slotIndex];
+    slot.dense = (uint32_t)m_dense.size();
+    slot.alive = true;
+
+    m_dense.push_back(Entity{});
+    m_denseToSlot.push_back(slotIndex);
+
+    Entity& e = m_dense.back();
+    e.id = MakeId(slotIndex, slot.generation);
+    return e;
+}
+
+void EntityPool::Destroy(EntityId id) {
+    const uint32_t slotIndex = SlotOf(id);
+    if (slotIndex >= m_slots.size()) return;
+
+    Slot& slot = m_slots[slotIndex];
+    if (!slot.alive || MakeId(slotIndex, slot.generation) != id) return;
+
+    // Swap-remove from the dense array and patch the moved entity's slot.
+    const uint32_t dense = slot.dense;
+    const uint32_t last = (uint32_t)m_dense.size() - 1;
+    if (dense != last) {
+        m_dense[dense] = std::move(m_dense[last]);
+        m_denseToSlot[dense] = m_denseToSlot[last];
+        m_slots[m_denseToSlot[dense]].dense = dense;
+    }
+    m_dense.pop_back();
+    m_denseToSlot.pop_back();
+
+    // Bump generation so stale handles stop resolving (skip 0 on wrap).
+    slot.alive = false;
+    slot.generation = (slot.generation + 1) & kGenerationMask;
+    if (slot.generation == 0) slot.generation = 1;
+    m_freeSlots.push_back(slotIndex);
+}
+
+void EntityPool::Clear() {
+    for (uint32_t slotIndex : m_denseToSlot) {
+        Slot& slot = m_slots[slotIndex];
+        slot.alive = false;
+        slot.generation = (slot.generation + 1) & kGenerationMask;
+        if (slot.generation == 0) slot.generation = 1;
+        m_freeSlots.push_back(slotIndex);
+    }
+    m_dense.clear();
+    m_denseToSlot.clear();
+}
+
+void EntityPool::Reserve(size_t n) {
+    m_dense.reserve(n);
+    m_denseToSlot.reserve(n);
+    m_slots.reserve(n);
+    m_freeSlots.reserve(n);
+}
+
+Entity* EntityPool::Get(EntityId id) {
+    const uint32_t slotIndex = SlotOf(id);
+    if (slotIndex >= m_slots.size()) return nullptr;
+
+    const Slot& slot = m_slots[slotIndex];
+    if (!slot.alive || MakeId(slotIndex, slot.generation) != id) return nullptr;
+    return &m_dense[slot.dense];
+}
+
+const Entity* EntityPool::Get(EntityId id) const {
+    return const_cast<EntityPool*>(this)->Get(id);
+}
+
+namespace {
+    // Fixed layout of one saved entity (everything but the waypoint vector,
+    // which follows all records). No implicit padding, so saved bytes are
+    // fully determined by the entity state.
+    struct EntityRecord {
+        uint32_t id;
+        uint8_t type, ai, enemyKind, pickupKind;
+        uint8_t active, dead, pad[2];
+        float pos[2], prevPos[2];
+        float radius, aggroRadius, moveSpeed;
+        int32_t health;
+        float invulnTimer, invulnDuration;
+        float velocity[2];
+        int32_t value;
+        float vel[2];
+        float hitstun;
+        int32_t pathIndex;
+        float repathTimer;
+        int32_t lastGoalTX, lastGoalTY;
+        uint32_t pathCount;
+    };
+    static_assert(sizeof(EntityRecord) == 96, "save format changed: bump the state version");
+
+    EntityRecord ToRecord(const Entity& e) {
+        EntityRecord r{};
+        r.id = e.id;
+        r.type = (uint8_t)e.type;
+        r.ai = (uint8_t)e.ai;
+        r.enemyKind = (uint8_t)e.enemyKind;
+        r.pickupKind = (uint8_t)e.pickupKind;
+        r.active = e.active ? 1 : 0;
+        r.dead = e.dead ? 1 : 0;
+        r.pos[0] = e.pos.x;          r.pos[1] = e.pos.y;
+        r.prevPos[0] = e.prevPos.x;  r.prevPos[1] = e.prevPos.y;
+        r.radius = e.radius;
+        r.aggroRadius = e.aggroRadius;
+        r.moveSpeed = e.moveSpeed;
+        r.health = e.health;
+        r.invulnTimer = e.invulnTimer;
+        r.invulnDuration = e.invulnDuration;
+        r.velocity[0] = e.velocity.x; r.velocity[1] = e.velocity.y;
+        r.value = e.value;
+        r.vel[0] = e.vel.x;          r.vel[1] = e.vel.y;
+        r.hitstun = e.hitstun;
+        r.pathIndex = e.path.index;
+        r.repathTimer = e.path.repathTimer;
+        r.lastGoalTX = e.path.lastGoalTX;
+        r.lastGoalTY = e.path.lastGoalTY;
+        r.pathCount = (uint32_t)e.path.waypoints.size();
+        return r;
+    }
+
+    bool InRange(const float* v, float limit) {
+        return std::isfinite(v[0]) && std::isfinite(v[1]) && std::fabs(v[0]) < limit && std::fabs(v[1]) < limit;
+    }
+
+    // Rejects values the simulation would index or convert with (enums,
+    // path cursor, positions), so a corrupt blob can't cause UB later.
+    bool ValidRecord(const EntityRecord& r) {
+        constexpr float kMaxCoord = 1e7f;
+        return r.type <= (uint8_t)EntityType::Pickup &&
+            r.ai <= (uint8_t)AIState::Seek &&
+            r.enemyKind <= (uint8_t)EnemyKind::Tank &&
+            r.pickupKind <= (uint8_t)PickupKind::Shield &&
+            r.pathIndex >= 0 && (uint32_t)r.pathIndex <= r.pathCount &&
+            InRange(r.pos, kMaxCoord) && InRange(r.prevPos, kMaxCoord) &&
+            std::isfinite(r.radius) && r.radius >= 0.0f && r.radius < kMaxCoord;
+    }
+
+    void FromRecord(const EntityRecord& r, Entity& e) {
+        e.id = r.id;
+        e.type = (EntityType)r.type;
+        e.ai = (AIState)r.ai;
+        e.enemyKind = (EnemyKind)r.enemyKind;
+        e.pickupKind = (PickupKind)r.pickupKind;
+        e.active = r.active != 0;
+        e.dead = r.dead != 0;
+        e.pos = { r.pos[0], r.pos[1] };
+        e.prevPos = { r.prevPos[0], r.prevPos[1] };
+        e.radius = r.radius;
+        e.aggroRadius = r.aggroRadius;
+        e.moveSpeed = r.moveSpeed;
+        e.health = r.health;
+        e.invulnTimer = r.invulnTimer;
+        e.invulnDuration = r.invulnDuration;
+        e.velocity = { r.velocity[0], r.velocity[1] };
+        e.value = r.value;
+        e.vel = { r.vel[0], r.vel[1] };
+        e.hitstun = r.hitstun;
+        e.path.index = r.pathIndex;
+        e.path.repathTimer = r.repathTimer;
+        e.path.lastGoalTX = r.lastGoalTX;
+        e.path.lastGoalTY = r.lastGoalTY;
+    }
+}
+
+void EntityPool::Save(BinaryWriter& w) const {
+    // Slot table: generation per slot; alive/dense are implied by m_denseToSlot.
+    w.Write<uint32_t>((uint32_t)m_slots.size());
+    for (const Slot& slot : m_slots) w.Write<uint32_t>(slot.generation);
+    w.WriteArray(m_denseToSlot.data(), m_denseToSlot.size());
+    w.WriteArray(m_freeSlots.data(), m_freeSlots.size());
+
+    // Entities as one block of fixed records, then every path back to back.
+    w.Write<uint32_t>((uint32_t)m_dense.size());
+    for (const Entity& e : m_dense) w.Write(ToRecord(e));
+    for (const Entity& e : m_dense) {
+        w.Bytes(e.path.waypoints.data(), e.path.waypoints.size() * sizeof(Vec2));
+    }
+}
+
+bool EntityPool::Load(BinaryReader& r) {
+    constexpr size_t kMaxSlots = (size_t)kSlotMask + 1;
+
+    uint32_t slotCount = 0;
+    if (!r.Read(slotCount) || slotCount > kMaxSlots) return false;
+
+    std::vector<Slot> slots(slotCount);
+    for (Slot& slot : slots) {
+        if (!r.Read(slot.generation)) return false;
+        if (slot.generation == 0 || slot.generation > kGenerationMask) return false;
+    }
+
+    std::vector<uint32_t> denseToSlot;
+    std::vector<uint32_t> freeSlots;
+    if (!r.ReadArray(denseToSlot, slotCount) || !r.ReadArray(freeSlots, slotCount)) return false;
+
+    for (size_t i = 0; i < denseToSlot.size(); ++i) {
+        const uint32_t s = denseToSlot[i];
+        if (s >= slotCount || slots[s].alive) return false;
+        slots[s].alive = true;
+        slots[s].dense = (uint32_t)i;
+    }
+    std::vector<uint8_t> freed(slotCount, 0);
+    for (uint32_t s : freeSlots) {
+        if (s >= slotCount || slots[s].alive || freed[s]) return false;
+        freed[s] = 1;
+    }
+
+    uint32_t count = 0;
+    if (!r.Read(count) || count != denseToSlot.size()) return false;
+
+    std::vector<Entity> dense(count);
+    std::vector<uint32_t> pathCounts(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        EntityRecord rec{};
+        if (!r.Read(rec)) return false;
+        const uint32_t s = denseToSlot[i];
+        if (rec.id != MakeId(s, slots[s].generation) || !ValidRecord(rec)) return false;
+        FromRecord(rec, dense[i]);
+        pathCounts[i] = rec.pathCount;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        if (pathCounts[i] > r.Remaining() / sizeof(Vec2)) return false;
+        std::vector<Vec2>& wps = dense[i].path.waypoints;
+        wps.resize(pathCounts[i]);
+        if (!r.Bytes(wps.data(), wps.size() * sizeof(Vec2))) return false;
+    }
+
+    m_dense = std::move(dense);
+    m_denseToSlot = std::move(denseToSlot);
+    m_slots = std::move(slots);
+    m_freeSlots = std::move(freeSlots);
+    return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "game/Entity.h"
+
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * Slot-map entity storage.
+ *
+ * Live entities are packed in a dense array (iteration touches live entities
+ * only). Each entity is addressed by a generational EntityId that stays valid
+ * while the entity lives and fails lookup once it is destroyed, even if the
+ * slot gets reused.
+ *
+ * Destroy() swap-removes: the last entity moves into the freed dense index,
+ * so dense references/indices are not stable across Destroy/Create. Hold an
+ * EntityId when you need to find an entity again.
+ */
+class EntityPool {
+public:
+    // EntityId layout: [generation:12][slot:20]. Generation 0 is never used,
+    // so an id of 0 is always invalid.
+    static constexpr uint32_t kSlotBits = 20;
+    static constexpr uint32_t kSlotMask = (1u << kSlotBits) - 1u;
+    static constexpr uint32_t kGenerationMask = (1u << (32 - kSlotBits)) - 1u;
+
+    static uint32_t SlotOf(EntityId id) { return id & kSlotMask; }
+    static uint32_t GenerationOf(EntityId id) { return id >> kSlotBits; }
+
+    // Creates a default entity and assigns its id. The reference is valid
+    // until the next Create/Destroy.
+    Entity& Create();
+    void Destroy(EntityId id);
+    void Clear();
+    void Reserve(size_t n);
+
+    Entity* Get(EntityId id);
+    const Entity* Get(EntityId id) const;
+    bool Alive(EntityId id) const { return Get(id) != nullptr; }
+
+    // Dense access (live entities only)
+    size_t Size() const { return m_dense.size(); }
+    bool Empty() const { return m_dense.empty(); }
+    Entity& operator[](size_t i) { return m_dense[i]; }
+    const Entity& operator[](size_t i) const { return m_dense[i]; }
+
+    std::vector<Entity>::iterator begin() { return m_dense.begin(); }
+    std::vector<Entity>::iterator end() { return m_dense.end(); }
+    std::vector<Entity>::const_iterator begin() const { return m_dense.begin(); }
+    std::vector<Entity>::const_iterator end() const { return m_dense.end(); }
+
+    // Save-state support. Slot generations and free-list order round-trip,
+    // so ids saved elsewhere (player handle, pickup index) stay valid.
+    // Load leaves the pool untouched if the data is malformed.
+    void Save(BinaryWriter& w) const;
+    bool Load(BinaryReader& r);
+
+private:
+    struct Slot {
+        uint32_t dense = 0;         // index into m_dense while alive
+        uint32_t generation = 1;
+        bool alive = false;
+    };
+
+    static EntityId MakeId(uint32_t slot, uint32_t generation) {
+        return (generation << kSlotBits) | slot;
+    }
+
+    std::vector<Entity>   m_dense;
+    std::vector<uint32_t> m_denseToSlot;
+    std::vector<Slot>     m_slots;
+    std::vector<uint32_t> m_freeSlots;
+};
@@ -3,25 +3,52 @@
 #include "game/Pathfinding.h"
 #include <cmath>
 #include <cstdio>
-#include <filesystem>
 #include <algorithm>
 #include <engine/Assets.h>
 #include "engine/Paths.h"
+#include "engine/AllocTracker.h"
+#include "engine/Profiler.h"
+#include "engine/Counters.h"
+#include "engine/Log.h"
+#include "engine/BinaryStream.h"
+#include "engine/Hash.h"
 // -----------------------------
 // Collision (circle vs circle)
 // -----------------------------
+static Counter s_pairsTested("collision.pairsTested");
+static Counter s_pairsResolved("collision.pairsResolved");
+static Counter s_renderCulled("render.culled");
+
+// Every pair test goes through here, so it is the one place that counts them.
 static bool CheckCollision(const Entity& a, const Entity& b) {
+	s_pairsTested.Add();
 	Vec2 d = a.pos - b.pos;
 	float distSq = d.x * d.x + d.y * d.y;
 	float r = a.radius + b.radius;
 	return distSq <= r * r;
 }
 
+static void FillDebugRow(const Entity& e, DebugState::EntityDebugRow& row) {
+	row.id = e.id;
+	row.slot = EntityPool::SlotOf(e.id);
+	row.generation = EntityPool::GenerationOf(e.id);
+	if (e.type == EntityType::Player) row.type = 0;
+	else if (e.type == EntityType::Enemy) row.type = 1;
+	else if (e.type == EntityType::Pickup) row.type = 2;
+	else row.type = 3;
+	row.x = e.pos.x;
+	row.y = e.pos.y;
+	row.radius = e.radius;
+	row.ai = (e.type == EntityType::Enemy && e.ai == AIState::Seek) ? 1 : 0;
+}
+
+// Call after CheckCollision has passed.
 static void SeparateEntities(Entity& a, Entity& b) {
 	Vec2 d = a.pos - b.pos;
 	float distSq = d.x * d.x + d.y * d.y;
 	float r = a.radius + b.radius;
 	if (distSq >= r * r) return;
+	s_pairsResolved.Add();
 
 	float dist = std::sqrt(std::max(distSq, 0.0001f));
 	Vec2 n = d * (1.0f / dist);
@@ -35,24 +62,25 @@ static void SeparateEntities(Entity& a, Entity& b) {
 // ECS-lite: entity creation
 // -----------------------------
 Entity& Game::CreateEntity(EntityType type, Vec2 pos, float radius) {
-	Entity e{};
-	e.id = m_nextEntityId++;
+	Entity& e = m_entities.Create();
 	e.type = type;
 	e.pos = pos;
 	e.prevPos = pos;
 	e.radius = radius;
 	e.ai = AIState::Idle;
 	e.aggroRadius = 350.0f;
-	m_entities.push_back(e);
-	return m_entities.back();
+	return e;
 }
 
 bool Game::Init(SdlPlatform& platform) {
-	// Assets must init first or sprites won't render
-	if (!m_assets.Init(platform))
+	// Assets must init first or sprites won't render (nothing to render headless)
+	if (!platform.IsHeadless() && !m_assets.Init(platform))
 		return false;
 
+	m_frameArena.Init(kFrameArenaBytes);
+
 	m_map.LoadCSV("assets/maps/level01.csv");
+	BuildSpawnTable();
 
 	// Load config (speeds, world size, etc.)
 	LoadGameConfig(AssetPath("assets/config.json").c_str(), m_cfg);
@@ -61,35 +89,66 @@ bool Game::Init(SdlPlatform& platform) {
 	m_camera.SetZoom(1.0f);
 	m_camera.SetShakeOffset({ 0.0f, 0.0f });
 
-	// Hot-reload timestamp init
-	try {
-		m_cfgTimestamp = std::filesystem::last_write_time("assets/config.json");
+	// Hot-reload: config, maps and textures are watched off-thread
+	if (!platform.IsHeadless()) {
+		m_assetWatcher.Start({ "assets", "assets/maps" });
 	}
-	catch (...) {}
-	m_cfgPollTimer = 0.0f;
 
 	// Build entities (player/enemies/pickups) from the CSV markers
 	RestartGame();
 
 	// Center camera on player after spawn
-	int winW = 0, winH = 0;
-	platform.GetWindowSize(winW, winH);
-	const Entity& player = m_entities[m_playerIndex];
-	m_camera.SetPosition(player.pos - Vec2{ (winW * 0.5f), (winH * 0.5f) });
+	platform.GetWindowSize(m_viewW, m_viewH);
+	const Entity& player = Player();
+	m_camera.SetPosition(player.pos - Vec2{ (m_viewW * 0.5f), (m_viewH * 0.5f) });
+
+	// Render has something to show before the first fixed step
+	PublishRenderSnapshot();
 
 	return true;
 }
 
 void Game::ClampPlayerToWorld(Entity& player) const {
-	// Keep the entire sprite inside world bounds by clamping using half extents.
-	const auto& tex = m_assets.Player();
-	const float halfW = tex.Width() * 0.5f;
-	const float halfH = tex.Height() * 0.5f;
+	// Keep the player's collision circle inside world bounds. Step must not
+	// read sprite sizes: they are 0x0 until the upload lands (always, headless).
+	const float r = player.radius;
+	const Vec2 world = WorldExtent();
+	if (player.pos.x < r) player.pos.x = r;
+	if (player.pos.y < r) player.pos.y = r;
+	if (player.pos.x > world.x - r) player.pos.x = world.x - r;
+	if (player.pos.y > world.y - r) player.pos.y = world.y - r;
+}
 
-	if (player.pos.x < halfW) player.pos.x = halfW;
-	if (player.pos.y < halfH) player.pos.y = halfH;
-	if (player.pos.x > m_worldSize.x - halfW) player.pos.x = m_worldSize.x - halfW;
-	if (player.pos.y > m_worldSize.y - halfH) player.pos.y = m_worldSize.y - halfH;
+Vec2 Game::WorldExtent() const {
+	// Maps bigger than the configured world (generated levels) extend it.
+	return Vec2{ std::max(m_worldSize.x, m_map.Width() * (float)m_map.TileSize()),
+		std::max(m_worldSize.y, m_map.Height() * (float)m_map.TileSize()) };
+}
+
+void Game::QueryVisibleSet() {
+	m_grid.Build(m_entities, WorldExtent(), kGridCellSize);
+	m_visibleSet.clear();
+	m_grid.Query(m_entities, m_camera.ViewRect(m_viewW, m_viewH, kViewMarginPx), m_visibleSet);
+}
+
+void Game::LoadMap(const Tilemap& map) {
+	m_map = map;
+	BuildSpawnTable();
+	RestartGame();
+	PublishRenderSnapshot();
+}
+
+void Game::Restart() {
+	RestartGame();
+	PublishRenderSnapshot();
+}
+
+bool Game::IsPlaying() const {
+	return m_flowState == FlowState::Playing;
+}
+
+bool Game::IsWon() const {
+	return m_flowState == FlowState::Win;
 }
 
 void Game::UpdateCameraFollow(SdlPlatform& platform, const Entity& player)
@@ -129,7 +188,37 @@ void Game::UpdateCameraFollow(SdlPlatform& platform, const Entity& player)
 
 
 void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, DebugState& dbg) {
-	Entity& player = m_entities[m_playerIndex];
+	// Everything allocated from the arena two steps ago is dead now. Maps
+	// change in many places (level advance, hot reload, LoadState), so the
+	// arena is sized for the current one as it is recycled.
+	const size_t tiles = (size_t)std::max(0, m_map.Width()) * (size_t)std::max(0, m_map.Height());
+	m_frameArena.Swap(kFrameArenaBytes + tiles * kFrameArenaBytesPerTile);
+
+	Step(platform, input, fixedDt, dbg);
+
+	const LinearArena& arena = m_frameArena.Current();
+	const LinearArena& prevArena = m_frameArena.Previous();
+	dbg.arenaUsedBytes = (int)arena.Used();
+	dbg.arenaHighWaterBytes = (int)std::max(arena.HighWater(), prevArena.HighWater());
+	dbg.arenaCapacityBytes = (int)arena.Capacity();
+	dbg.arenaOverflows = (int)(arena.Overflows() + prevArena.Overflows());
+
+	++m_tick;
+
+	PROFILE_ZONE("Game.Publish");
+	PublishRenderSnapshot();
+}
+
+void Game::Step(SdlPlatform& platform, const Input& input, float fixedDt, DebugState& dbg) {
+	// The player is created first, so it sits at dense index 0 and is never
+	// moved by swap-remove, but Create can reallocate the pool. The only
+	// creation in Step is RestartGame in the win/lose branches, which use
+	// Player() afterwards and return; config reloads respawn enemies, so they
+	// run in ProcessAssetChanges instead of here.
+	Entity& player = Player();
+
+	// One zone per system; each Next() closes the previous one.
+	ProfileZone zone("Game.Flow");
 
 	auto TickCombatTimers = [&](Entity& e) {
 		if (e.hitstun > 0.0f) {
@@ -150,22 +239,18 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
 	// --------------------
 // AUTHORITATIVE FLOW INPUT (edge-triggered)
 // --------------------
-	static bool prevReturn = false;
-	static bool prevR = false;
-
 	const bool returnNow = input.Down(Key::Return);
 	const bool rNow = input.Down(Key::R);
 
-	const bool returnPressed = (returnNow && !prevReturn);
-	const bool rPressed = (rNow && !prevR);
+	const bool returnPressed = (returnNow && !m_prevReturn);
+	const bool rPressed = (rNow && !m_prevR);
 
-	prevReturn = returnNow;
-	prevR = rNow;
+	m_prevReturn = returnNow;
+	m_prevR = rNow;
 
-	static bool prevEscape = false;
 	bool escapeNow = input.Down(Key::Escape);
-	bool escapePressed = escapeNow && !prevEscape;
-	prevEscape = escapeNow;
+	bool escapePressed = escapeNow && !m_prevEscape;
+	m_prevEscape = escapeNow;
 
 	// Keep legacy flags in sync for any old render paths
 	m_gameWin = (m_flowState == FlowState::Win);
@@ -184,13 +269,14 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
 			char mapPath[64];
 			std::snprintf(mapPath, sizeof(mapPath), "assets/maps/level%02d.csv", m_currentLevel);
 			m_map.LoadCSV(mapPath);
+			BuildSpawnTable();
 
 			RestartGame();                 // rebuilds entities from CSV markers
 			m_flowState = FlowState::Playing;
 		}
 
 		// Update debug info and stop simulation while in win screen
-		dbg.playerPos = player.pos;
+		dbg.playerPos = Player().pos;
 		dbg.cameraPos = m_camera.Position();
 		return;
 	}
@@ -202,7 +288,7 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
 			m_flowState = FlowState::Playing;
 		}
 
-		dbg.playerPos = player.pos;
+		dbg.playerPos = Player().pos;
 		dbg.cameraPos = m_camera.Position();
 		return;
 	}
@@ -217,50 +303,24 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
         return;
     }
 
-	// --------------------
-	// HOT-RELOAD POLLING (runs even if paused)
-	// --------------------
-	m_cfgPollTimer += fixedDt;
-	if (m_cfgPollTimer >= 1.0f) {
-		m_cfgPollTimer = 0.0f;
-		try {
-			auto t = std::filesystem::last_write_time("assets/config.json");
-			if (t != m_cfgTimestamp) {
-				m_cfgTimestamp = t;
-				ReloadConfig("assets/config.json");
-				std::printf("[HOTRELOAD] config.json reloaded\n");
-			}
-		}
-		catch (...) {}
-	}
-
-	// --------------------
-	// MANUAL RELOAD (ImGui button)
-	// --------------------
-	if (dbg.requestReloadConfig) {
-		dbg.requestReloadConfig = false;
-		ReloadConfig("assets/config.json");
-	}
-
 	// --------------------
 	// Toggle debug UI with Tab (edge-triggered)
 	// --------------------
-	static bool prevTab = false;
 	bool tabNow = input.Down(Key::Tab);
-	if (tabNow && !prevTab) {
+	if (tabNow && !m_prevTab) {
 		// If you keep imguiWantsKeyboard, this prevents fighting ImGui focus
 		if (!dbg.imguiWantsKeyboard) {
 			dbg.showUI = !dbg.showUI;
 		}
 	}
-	prevTab = tabNow;
+	m_prevTab = tabNow;
 
 	// --------------------
 	// PAUSE HANDLING
 	// --------------------
 	if (dbg.pause) {
-		dbg.entityCount = (int)m_entities.size();
-		dbg.playerPos = m_entities[m_playerIndex].pos;
+		dbg.entityCount = (int)m_entities.Size();
+		dbg.playerPos = player.pos;
 		dbg.cameraPos = m_camera.Position();
 		return;
 	}
@@ -312,6 +372,7 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
 
 // INPUT SYSTEM (player)
 	// --------------------
+	zone.Next("Game.Player");
 	player.prevPos = player.pos;
 
 	if (player.hitstun <= 0.0f) {
@@ -348,13 +409,46 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
 	// --------------------
 	// AI SYSTEM (Idle -> Seek)
 	// --------------------
+	zone.Next("Game.AI");
+
+	// LOD: enemies on screen or near the player tick every step; the rest
+	// tick every Nth step (staggered by id) with a scaled dt.
+	platform.GetWindowSize(m_viewW, m_viewH);
+
+	if (dbg.aiLodInterval < 1) dbg.aiLodInterval = 1;
+	const int lodInterval = dbg.aiLodEnabled ? dbg.aiLodInterval : 1;
+	if (lodInterval > 1) {
+		QueryVisibleSet();
+		m_isVisible.assign(m_entities.Size(), 0);
+		for (uint32_t i : m_visibleSet) m_isVisible[i] = 1;
+	}
+	dbg.aiTicked = 0;
+	dbg.aiSkipped = 0;
 
-	for (size_t i = 0; i < m_entities.size(); ++i) {
+	for (size_t i = 0; i < m_entities.Size(); ++i) {
 		Entity& e = m_entities[i];
 		if (e.type != EntityType::Enemy) continue;
 
 		e.prevPos = e.pos;
 
+		float aiDt = fixedDt;
+		if (lodInterval > 1) {
+			const bool visible = m_isVisible[i] != 0;
+
+			Vec2 d = player.pos - e.pos;
+			const float nearRadius = e.aggroRadius * 1.25f; // covers Seek hysteresis
+			const bool nearPlayer = (d.x * d.x + d.y * d.y) <= nearRadius * nearRadius;
+
+			if (!visible && !nearPlayer) {
+				if ((m_tick + e.id) % (uint64_t)lodInterval != 0) {
+					dbg.aiSkipped++;
+					continue;
+				}
+				aiDt = fixedDt * (float)lodInterval;
+			}
+		}
+		dbg.aiTicked++;
+
 		Vec2 toPlayer = player.pos - e.pos;
 		float distSq = toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y;
 		float aggroSq = e.aggroRadius * e.aggroRadius;
@@ -370,23 +464,27 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
 
 		// Behavior
 		if (e.ai == AIState::Seek && distSq > 0.0001f) {
-			const float repathInterval = 0.25f;  // 4x/sec
+			const float repathInterval = 0.25f * dbg.aiRepathScale;  // 4x/sec, slower when throttled
 			const float waypointReach = 8.0f;
 			const float enemySpeed = (e.moveSpeed > 0.0f) ? e.moveSpeed : m_enemySpeed;
 
 			TileCoord goalT = m_map.WorldToTile(player.pos);
 
 			// timers
-			e.path.repathTimer -= fixedDt;
+			e.path.repathTimer -= aiDt;
 
 			// repath conditions
 			bool goalChanged = (goalT.x != e.path.lastGoalTX || goalT.y != e.path.lastGoalTY);
 			bool needPath = e.path.waypoints.empty() || e.path.index >= (int)e.path.waypoints.size();
 
 			if (e.path.repathTimer <= 0.0f && (goalChanged || needPath)) {
+				AllocScope allocScope(AllocTag::Pathfinding);
 				TileCoord startT = m_map.WorldToTile(e.pos);
 
-				auto tiles = Pathfinding::AStar(m_map, startT, goalT);
+				// Waypoints are copied out below, so each search's scratch is released
+				// before the next enemy repaths.
+				ArenaScope arenaScope(m_frameArena.Current());
+				auto tiles = Pathfinding::AStar(m_map, startT, goalT, m_frameArena.Current());
 				e.path.waypoints.clear();
 				e.path.index = 0;
 
@@ -417,8 +515,8 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
 					Vec2 dir{ to.x * invLen, to.y * invLen };
 
 					e.pos = Vec2{
-						e.pos.x + dir.x * (enemySpeed * fixedDt),
-						e.pos.y + dir.y * (enemySpeed * fixedDt)
+						e.pos.x + dir.x * (enemySpeed * aiDt),
+						e.pos.y + dir.y * (enemySpeed * aiDt)
 					};
 				}
 			}
@@ -433,23 +531,26 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
 	// --------------------
 	// SEPARATION SYSTEM (enemy vs enemy)
 	// --------------------
-	for (size_t i = 0; i < m_entities.size(); ++i) {
+	zone.Next("Game.Separation");
+	for (size_t i = 0; i < m_entities.Size(); ++i) {
 		if (m_entities[i].type != EntityType::Enemy) continue;
 
-		for (size_t j = i + 1; j < m_entities.size(); ++j) {
+		for (size_t j = i + 1; j < m_entities.Size(); ++j) {
 			if (m_entities[j].type != EntityType::Enemy) continue;
 
-			SeparateEntities(m_entities[i], m_entities[j]);
+			if (CheckCollision(m_entities[i], m_entities[j])) {
+				SeparateEntities(m_entities[i], m_entities[j]);
+			}
 		}
 	}
 
 	// --------------------
 	// COLLISION SYSTEM (player vs enemies)
 	// --------------------
-	for (size_t i = 0; i < m_entities.size(); ++i) {
-		if ((int)i == m_playerIndex) continue;
-
+	zone.Next("Game.Collision");
+	for (size_t i = 0; i < m_entities.Size(); ++i) {
 		Entity& e = m_entities[i];
+		if (e.id == m_playerId) continue;
 		if (e.type != EntityType::Enemy) continue;
 
 
@@ -498,37 +599,49 @@ void Game::Update(SdlPlatform& platform, const Input& input, float fixedDt, Debu
 	// --------------------
 	// PICKUPS (player vs pickups)
 	// --------------------
-	for (Entity& e : m_entities) {
-		if (!e.active) continue;
-		if (e.type != EntityType::Pickup) continue;
-
-		if (!CheckCollision(player, e)) continue;
-
-		e.active = false;
-
-		switch (e.pickupKind) {
-		case PickupKind::Token:
-			m_tokensCollected += 1;
-			if (m_tokensCollected > m_tokensTotal) m_tokensCollected = m_tokensTotal;
-			m_pickupsRemaining = std::max(0, m_tokensTotal - m_tokensCollected);
-			if (m_tokensCollected >= m_tokensTotal && m_tokensTotal > 0) {
-				m_flowState = FlowState::Win;
+	zone.Next("Game.Pickups");
+	// Pickups are static and indexed by tile, so only the few tiles the
+	// player's circle (grown by the pickup radius) overlaps are checked.
+	const float pickupReach = player.radius + kPickupRadius;
+	const TileCoord pickMin = m_map.WorldToTile(player.pos - Vec2{ pickupReach, pickupReach });
+	const TileCoord pickMax = m_map.WorldToTile(player.pos + Vec2{ pickupReach, pickupReach });
+
+	for (int ty = pickMin.y; ty <= pickMax.y; ++ty) {
+		for (int tx = pickMin.x; tx <= pickMax.x; ++tx) {
+			auto it = m_pickupByTile.find(PickupTileKey(tx, ty));
+			if (it == m_pickupByTile.end()) continue;
+
+			const Entity* e = m_entities.Get(it->second);
+			if (!e || !CheckCollision(player, *e)) continue;
+
+			const PickupKind kind = e->pickupKind;
+			m_entities.Destroy(it->second);
+			m_pickupByTile.erase(it);
+
+			switch (kind) {
+			case PickupKind::Token:
+				m_tokensCollected += 1;
+				if (m_tokensCollected > m_tokensTotal) m_tokensCollected = m_tokensTotal;
+				m_pickupsRemaining = std::max(0, m_tokensTotal - m_tokensCollected);
+				if (m_tokensCollected >= m_tokensTotal && m_tokensTotal > 0) {
+					m_flowState = FlowState::Win;
+				}
+				break;
+			case PickupKind::Health:
+				// +1 heart (clamped)
+				if (player.health < m_playerMaxHealth) player.health += 1;
+				break;
+			case PickupKind::Speed:
+				// Temporary movement boost
+				m_speedBuffTimer = m_speedBuffDuration;
+				break;
+			case PickupKind::Shield:
+				// One-hit protection (timer also useful for UI)
+				m_shieldTimer = m_shieldDuration;
+				break;
+			default:
+				break;
 			}
-			break;
-		case PickupKind::Health:
-			// +1 heart (clamped)
-			if (player.health < m_playerMaxHealth) player.health += 1;
-			break;
-		case PickupKind::Speed:
-			// Temporary movement boost
-			m_speedBuffTimer = m_speedBuffDuration;
-			break;
-		case PickupKind::Shield:
-			// One-hit protection (timer also useful for UI)
-			m_shieldTimer = m_shieldDuration;
-			break;
-		default:
-			break;
 		}
 	}
 
@@ -539,6 +652,7 @@ if (player.health <= 0) {
 	// --------------------
 	// CAMERA SYSTEM (follow + clamp)
 	// --------------------
+	zone.Next("Game.Camera");
 	UpdateCameraFollow(platform, player);
 
 	// --------------------
@@ -549,13 +663,10 @@ if (player.health <= 0) {
 		m_shakeTime -= fixedDt;
 		if (m_shakeTime < 0.0f) m_shakeTime = 0.0f;
 
-		const float t = (m_shakeDuration - m_shakeTime) * 60.0f;
-		const float sx = std::sin(t * 12.9898f) * 43758.5453f;
-		const float sy = std::sin(t * 78.233f) * 12345.6789f;
-
-		auto frac = [](float v) { return v - std::floor(v); };
-		float nx = frac(sx) * 2.0f - 1.0f;
-		float ny = frac(sy) * 2.0f - 1.0f;
+		// Integer hash of the tick: same noise on every platform (no libm sin).
+		const uint32_t noise = HashU32((uint32_t)m_tick);
+		float nx = (float)(noise & 0xFFFFu) * (2.0f / 65535.0f) - 1.0f;
+		float ny = (float)(noise >> 16) * (2.0f / 65535.0f) - 1.0f;
 
 		float fade = (m_shakeDuration > 0.0f) ? (m_shakeTime / m_shakeDuration) : 0.0f;
 		shake = Vec2{ nx, ny } * (m_shakeStrength * fade);
@@ -565,37 +676,42 @@ if (player.health <= 0) {
 	// --------------------
 	// DEBUG OUTPUT (for UI)
 	// --------------------
-	dbg.entityCount = (int)m_entities.size();
+	zone.Next("Game.DebugOutput");
+	dbg.entityCount = (int)m_entities.Size();
 	dbg.enemyCount = std::max(0, dbg.entityCount - 1);
 	dbg.playerPos = player.pos;
 	dbg.cameraPos = m_camera.Position();
 	dbg.playerHealth = player.health;
 	dbg.gameOver = m_gameOver;
-	dbg.debugEntityCount = 0;
-	for (const Entity& e : m_entities) {
-		if (dbg.debugEntityCount >= DebugState::kMaxDebugEntities) break;
-		auto& row = dbg.debugEntities[dbg.debugEntityCount++];
+	dbg.entitySource = &m_inspector;   // rows are read lazily by the inspector
+}
 
-		row.id = e.id;
-		if (e.type == EntityType::Player) row.type = 0;
-		else if (e.type == EntityType::Enemy) row.type = 1;
-		else if (e.type == EntityType::Pickup) row.type = 2;
-		else row.type = 3;
-		row.x = e.pos.x;
-		row.y = e.pos.y;
-		row.radius = e.radius;
-		row.ai = (e.type == EntityType::Enemy && e.ai == AIState::Seek) ? 1 : 0;
-	}
+int Game::InspectorSource::EntityCount() const {
+	return (int)m_pool.Size();
+}
+
+bool Game::InspectorSource::EntityRow(int index, DebugState::EntityDebugRow& out) const {
+	if (index < 0 || index >= (int)m_pool.Size()) return false;
+	FillDebugRow(m_pool[(size_t)index], out);
+	return true;
 }
 
-void Game::DrawWorldGrid(SdlPlatform& platform) const {
+bool Game::InspectorSource::FindEntity(uint32_t id, DebugState::EntityDebugRow& out) const {
+	const Entity* e = m_pool.Get(id);
+	if (!e) return false;
+	FillDebugRow(*e, out);
+	return true;
+}
+
+void Game::DrawWorldGrid(SdlPlatform& platform, const Camera2D& cam) const {
 	const int step = 64;
 
 	int winW = 0, winH = 0;
 	platform.GetWindowSize(winW, winH);
 
-	Vec2 topLeft = m_camera.ScreenToWorld({ 0, 0 });
-	Vec2 bottomRight = m_camera.ScreenToWorld({ (float)winW, (float)winH });
+	const Aabb view = cam.ViewRect(winW, winH);
+	const Vec2 topLeft = view.min;
+	const Vec2 bottomRight = view.max;
 
 	int startX = (int)(topLeft.x / step) * step - step;
 	int endX = (int)(bottomRight.x / step) * step + step;
@@ -604,83 +720,228 @@ void Game::DrawWorldGrid(SdlPlatform& platform) const {
 	int endY = (int)(bottomRight.y / step) * step + step;
 
 	for (int wx = startX; wx <= endX; wx += step) {
-		Vec2 a = m_camera.WorldToScreen({ (float)wx, topLeft.y });
-		Vec2 b = m_camera.WorldToScreen({ (float)wx, bottomRight.y });
+		Vec2 a = cam.WorldToScreen({ (float)wx, topLeft.y });
+		Vec2 b = cam.WorldToScreen({ (float)wx, bottomRight.y });
 		platform.DrawLine((int)a.x, (int)a.y, (int)b.x, (int)b.y);
 	}
 
 	for (int wy = startY; wy <= endY; wy += step) {
-		Vec2 a = m_camera.WorldToScreen({ topLeft.x, (float)wy });
-		Vec2 b = m_camera.WorldToScreen({ bottomRight.x, (float)wy });
+		Vec2 a = cam.WorldToScreen({ topLeft.x, (float)wy });
+		Vec2 b = cam.WorldToScreen({ bottomRight.x, (float)wy });
 		platform.DrawLine((int)a.x, (int)a.y, (int)b.x, (int)b.y);
 	}
 }
 
-void Game::Render(SdlPlatform& platform, float alpha, const DebugState& dbg) {
-	if (m_playerIndex < 0 || m_playerIndex >= (int)m_entities.size())
-		return;
-
-	if (m_requestQuit)
+void Game::PublishRenderSnapshot() {
+	if (!m_entities.Alive(m_playerId))
 		return;
 
-	const Entity& player = m_entities[m_playerIndex];
-	const auto& playerTex = m_assets.Player();
-
-	if (dbg.showGrid) {
-		DrawWorldGrid(platform);
-	}
-
-	// World (tilemap first, then entities)
-	m_map.Render(platform, m_camera);
-
-	for (const Entity& e : m_entities) {
+	RenderSnapshot& snap = m_snapshots.WriteBuffer();
+	snap.tick = m_tick;
+	snap.valid = true;
+	snap.camera = m_camera;
+	snap.entities.clear();
+	snap.pathPoints.clear();
+
+	// Only the visible set; render never sees off-screen entities
+	QueryVisibleSet();
+	for (uint32_t index : m_visibleSet) {
+		const Entity& e = m_entities[index];
 		if (!e.active) continue;
-		const Vec2 worldPos = e.prevPos + (e.pos - e.prevPos) * alpha;
-		const Vec2 screenPos = m_camera.WorldToScreen(worldPos);
+
+		RenderEntity re{};
+		re.pos = e.pos;
+		re.prevPos = e.prevPos;
+		re.radius = e.radius;
 
 		if (e.type == EntityType::Player) {
+			re.kind = RenderKind::Player;
 			// Blink while invulnerable
 			if (e.invulnTimer > 0.0f) {
 				const int phase = (int)(e.invulnTimer * 20.0f);
-				if ((phase & 1) == 0) {
-					continue;
-				}
+				re.visible = (phase & 1) != 0;
 			}
-
-			const int drawX = (int)(screenPos.x - playerTex.Width() * 0.5f);
-			const int drawY = (int)(screenPos.y - playerTex.Height() * 0.5f);
-			platform.DrawSprite(playerTex, drawX, drawY);
 		}
 		else if (e.type == EntityType::Pickup) {
-			Vec2 screen = m_camera.WorldToScreen(e.pos);
+			re.kind = RenderKind::Pickup;
 			// Color by pickup kind
 			switch (e.pickupKind) {
-			case PickupKind::Token:  platform.DrawFilledRect((int)screen.x - 8, (int)screen.y - 8, 16, 16, 255, 255, 0); break; // yellow
-			case PickupKind::Health: platform.DrawFilledRect((int)screen.x - 8, (int)screen.y - 8, 16, 16,  80, 220, 80); break; // green
-			case PickupKind::Speed:  platform.DrawFilledRect((int)screen.x - 8, (int)screen.y - 8, 16, 16,  80, 160, 255); break; // blue
-			case PickupKind::Shield: platform.DrawFilledRect((int)screen.x - 8, (int)screen.y - 8, 16, 16, 180,  80, 220); break; // purple
-			default:                platform.DrawFilledRect((int)screen.x - 8, (int)screen.y - 8, 16, 16, 120, 120, 120); break;
+			case PickupKind::Token:  re.r = 255; re.g = 255; re.b = 0;   break; // yellow
+			case PickupKind::Health: re.r = 80;  re.g = 220; re.b = 80;  break; // green
+			case PickupKind::Speed:  re.r = 80;  re.g = 160; re.b = 255; break; // blue
+			case PickupKind::Shield: re.r = 180; re.g = 80;  re.b = 220; break; // purple
+			default:                 re.r = 120; re.g = 120; re.b = 120; break;
 			}
 		}
 		else {
-			if (dbg.showPaths && e.type == EntityType::Enemy) {
-				for (int i = e.path.index; i + 1 < (int)e.path.waypoints.size(); ++i) {
-					Vec2 a = m_camera.WorldToScreen(e.path.waypoints[i]);
-					Vec2 b = m_camera.WorldToScreen(e.path.waypoints[i + 1]);
-					platform.DrawLine((int)a.x, (int)a.y, (int)b.x, (int)b.y);
+			re.kind = RenderKind::Enemy;
+			re.r = 200; re.g = 80; re.b = 80; // chaser default
+			switch (e.enemyKind) {
+			case EnemyKind::Fast: re.r = 80; re.g = 200; re.b = 80; break;
+			case EnemyKind::Tank: re.r = 80; re.g = 80; re.b = 200; break;
+			default: break;
+			}
+
+			// Remaining path (from current waypoint on)
+			re.pathBegin = (uint32_t)snap.pathPoints.size();
+			for (int i = e.path.index; i < (int)e.path.waypoints.size(); ++i) {
+				snap.pathPoints.push_back(e.path.waypoints[i]);
+			}
+			re.pathCount = (uint32_t)snap.pathPoints.size() - re.pathBegin;
+		}
+
+		snap.entities.push_back(re);
+	}
+
+	const Entity& player = Player();
+	snap.playerHealth = player.health;
+	snap.playerMaxHealth = m_playerMaxHealth;
+	snap.tokensCollected = m_tokensCollected;
+	snap.tokensTotal = m_tokensTotal;
+	snap.speedBuff = (m_speedBuffTimer > 0.0f);
+	snap.shield = (m_shieldTimer > 0.0f);
+
+	switch (m_flowState) {
+	case FlowState::Win:         snap.flow = RenderFlow::Win; break;
+	case FlowState::Lose:        snap.flow = RenderFlow::Lose; break;
+	case FlowState::QuitConfirm: snap.flow = RenderFlow::QuitConfirm; break;
+	default:                     snap.flow = RenderFlow::Playing; break;
+	}
+
+	m_snapshots.Publish();
+}
+
+void Game::PrepareDrawList(const RenderSnapshot& snap, float alpha, bool showPaths, int viewW, int viewH) {
+	const Camera2D::ScreenTransform xf = snap.camera.WorldToScreenTransform();
+	const RenderEntity* ents = snap.entities.data();
+	const size_t count = snap.entities.size();
+
+	// Sweep 1: interpolate + transform every entity (straight-line, no culling yet)
+	m_screenPos.resize(count);
+	Vec2* screen = m_screenPos.data();
+	for (size_t i = 0; i < count; ++i) {
+		screen[i] = xf.Apply(ents[i].prevPos + (ents[i].pos - ents[i].prevPos) * alpha);
+	}
+
+	// Sweep 2: path points, each transformed once (adjacent segments share them)
+	if (showPaths) {
+		const size_t pathCount = snap.pathPoints.size();
+		m_screenPath.resize(pathCount);
+		const Vec2* world = snap.pathPoints.data();
+		Vec2* path = m_screenPath.data();
+		for (size_t i = 0; i < pathCount; ++i) {
+			path[i] = xf.Apply(world[i]);
+		}
+	}
+
+	// Emit in snapshot order (draw order), culling against the viewport
+	const auto RectVisible = [viewW, viewH](const DrawPrim& p) {
+		return p.x + p.w > 0 && p.y + p.h > 0 && p.x < viewW && p.y < viewH;
+	};
+	const auto LineVisible = [viewW, viewH](const DrawPrim& p) {
+		return !((p.x < 0 && p.w < 0) || (p.y < 0 && p.h < 0) ||
+			(p.x >= viewW && p.w >= viewW) || (p.y >= viewH && p.h >= viewH));
+	};
+	int culled = 0;
+	auto Emit = [&](const DrawPrim& p, bool visible) {
+		if (visible) m_drawList.push_back(p);
+		else ++culled;
+	};
+
+	const auto& playerTex = m_assets.Player();
+	m_drawList.clear();
+
+	for (size_t i = 0; i < count; ++i) {
+		const RenderEntity& e = ents[i];
+		const Vec2 s = screen[i];
+		DrawPrim p;
+
+		if (e.kind == RenderKind::Player) {
+			if (!e.visible || !playerTex.texture) continue;
+
+			p.type = DrawPrim::Type::Sprite;
+			p.w = playerTex.Width();
+			p.h = playerTex.Height();
+			p.x = (int)(s.x - p.w * 0.5f);
+			p.y = (int)(s.y - p.h * 0.5f);
+			Emit(p, RectVisible(p));
+		}
+		else if (e.kind == RenderKind::Pickup) {
+			p.r = e.r; p.g = e.g; p.b = e.b;
+			p.x = (int)s.x - 8;
+			p.y = (int)s.y - 8;
+			p.w = 16;
+			p.h = 16;
+			Emit(p, RectVisible(p));
+		}
+		else {
+			if (showPaths) {
+				const Vec2* pts = m_screenPath.data() + e.pathBegin;
+				DrawPrim line;
+				line.type = DrawPrim::Type::Line;
+				for (uint32_t k = 0; k + 1 < e.pathCount; ++k) {
+					line.x = (int)pts[k].x;
+					line.y = (int)pts[k].y;
+					line.w = (int)pts[k + 1].x;
+					line.h = (int)pts[k + 1].y;
+					Emit(line, LineVisible(line));
 				}
 			}
 
 			const int size = (int)(e.radius * 2.0f);
-			const int drawX = (int)(screenPos.x - size * 0.5f);
-			const int drawY = (int)(screenPos.y - size * 0.5f);
-			int r = 200, g = 80, b = 80; // chaser default
-			switch (e.enemyKind) {
-			case EnemyKind::Fast: r = 80; g = 200; b = 80; break;
-			case EnemyKind::Tank: r = 80; g = 80; b = 200; break;
-			default: break;
-			}
-			platform.DrawFilledRect(drawX, drawY, size, size, (uint8_t)r, (uint8_t)g, (uint8_t)b);
+			p.r = e.r; p.g = e.g; p.b = e.b;
+			p.x = (int)(s.x - size * 0.5f);
+			p.y = (int)(s.y - size * 0.5f);
+			p.w = size;
+			p.h = size;
+			Emit(p, RectVisible(p));
+		}
+	}
+	s_renderCulled.Add(culled);
+}
+
+void Game::Render(SdlPlatform& platform, float alpha, const DebugState& dbg) {
+	// Finish any async texture loads (GPU upload must happen on this thread)
+	m_assets.Update();
+
+	m_snapshots.Acquire();
+	const RenderSnapshot& snap = m_snapshots.ReadBuffer();
+	if (!snap.valid)
+		return;
+
+	if (m_requestQuit)
+		return;
+
+	const Camera2D& cam = snap.camera;
+	const auto& playerTex = m_assets.Player();
+
+	if (dbg.showGrid) {
+		DrawWorldGrid(platform, cam);
+	}
+
+	// World (tilemap first, then entities)
+	m_map.Render(platform, cam);
+
+	int viewW = 0, viewH = 0;
+	platform.GetWindowSize(viewW, viewH);
+	{
+		PROFILE_ZONE("Game.RenderPrep");
+		PrepareDrawList(snap, alpha, dbg.showPaths, viewW, viewH);
+	}
+
+	for (const DrawPrim& p : m_drawList) {
+		switch (p.type) {
+		case DrawPrim::Type::Sprite: {
+			const AtlasRect& src = playerTex.rect;
+			platform.DrawSprite(*playerTex.texture, src.x, src.y, src.w, src.h, p.x, p.y);
+			break;
+		}
+		case DrawPrim::Type::Rect:
+			platform.DrawFilledRect(p.x, p.y, p.w, p.h, p.r, p.g, p.b);
+			break;
+		case DrawPrim::Type::Line:
+			platform.DrawLine(p.x, p.y, p.w, p.h);
+			break;
 		}
 	}
 
@@ -689,8 +950,8 @@ void Game::Render(SdlPlatform& platform, float alpha, const DebugState& dbg) {
 	// --------------------
 	// HUD (screen-space)
 	// --------------------
-	const int maxH = std::max(1, dbg.playerMaxHealth);
-	const int curH = std::max(0, std::min(player.health, maxH));
+	const int maxH = std::max(1, snap.playerMaxHealth);
+	const int curH = std::max(0, std::min(snap.playerHealth, maxH));
 
 	int x = 16, y = 16;
 	for (int i = 0; i < curH; ++i) {
@@ -707,8 +968,8 @@ void Game::Render(SdlPlatform& platform, float alpha, const DebugState& dbg) {
 	const int tokenX = 16;
 	const int tokenY = 16 + tokenStep; // one row below hearts
 
-	const int totalTokens = std::max(0, m_tokensTotal);
-	const int collected = std::max(0, std::min(m_tokensCollected, totalTokens));
+	const int totalTokens = std::max(0, snap.tokensTotal);
+	const int collected = std::max(0, std::min(snap.tokensCollected, totalTokens));
 
 	for (int i = 0; i < totalTokens; ++i) {
 		if (i < collected) {
@@ -721,13 +982,13 @@ void Game::Render(SdlPlatform& platform, float alpha, const DebugState& dbg) {
 	// Buff indicators (same size as hearts/tokens)
 	const int buffY = tokenY + tokenStep;
 	// Speed
-	if (m_speedBuffTimer > 0.0f) platform.DrawFilledRect(tokenX, buffY, tokenSize, tokenSize, 80, 160, 255);
+	if (snap.speedBuff)           platform.DrawFilledRect(tokenX, buffY, tokenSize, tokenSize, 80, 160, 255);
 	else                         platform.DrawFilledRect(tokenX, buffY, tokenSize, tokenSize, 40, 40, 40);
 	// Shield
-	if (m_shieldTimer > 0.0f)    platform.DrawFilledRect(tokenX + tokenStep, buffY, tokenSize, tokenSize, 180, 80, 220);
+	if (snap.shield)              platform.DrawFilledRect(tokenX + tokenStep, buffY, tokenSize, tokenSize, 180, 80, 220);
 	else                         platform.DrawFilledRect(tokenX + tokenStep, buffY, tokenSize, tokenSize, 40, 40, 40);
 
-	if (m_flowState == FlowState::QuitConfirm) {
+	if (snap.flow == RenderFlow::QuitConfirm) {
 		int w = 0, h = 0;
 		platform.GetWindowSize(w, h);
 
@@ -748,7 +1009,7 @@ void Game::Render(SdlPlatform& platform, float alpha, const DebugState& dbg) {
 // --------------------
 	// Game Over overlay (no text renderer yet)
 	// --------------------
-	if (m_gameOver) {
+	if (snap.flow == RenderFlow::Lose) {
 		int w = 0, h = 0;
 		platform.GetWindowSize(w, h);
 
@@ -765,7 +1026,7 @@ void Game::Render(SdlPlatform& platform, float alpha, const DebugState& dbg) {
 		const int hh = 22;
 		platform.DrawFilledRect((w - hw) / 2, (h - bh) / 2 + bh + 18, hw, hh, 80, 80, 80);
 	}
-	if (m_gameWin) {
+	if (snap.flow == RenderFlow::Win) {
 		int w = 0, h = 0;
 		platform.GetWindowSize(w, h);
 
@@ -774,48 +1035,85 @@ void Game::Render(SdlPlatform& platform, float alpha, const DebugState& dbg) {
 	}
 
 }
+void Game::ProcessAssetChanges(SdlPlatform& platform, DebugState& dbg) {
+	// Manual reload (ImGui button). Respawns enemies, so it must not run
+	// inside Step while the player reference is held.
+	if (dbg.requestReloadConfig) {
+		dbg.requestReloadConfig = false;
+		ReloadConfig("assets/config.json");
+	}
+
+	m_assetChanges.clear();
+	m_assetWatcher.Drain(m_assetChanges);
+
+	for (const AssetChange& c : m_assetChanges) {
+		switch (c.kind) {
+		case AssetKind::Config:
+			if (c.path == "assets/config.json" && ReloadConfig(c.path.c_str())) {
+				LOG_INFO(LogCategory::HotReload, "%s reloaded", c.path.c_str());
+			}
+			break;
+		case AssetKind::Map: {
+			char mapPath[64];
+			std::snprintf(mapPath, sizeof(mapPath), "assets/maps/level%02d.csv", m_currentLevel);
+			if (c.path == mapPath && m_map.LoadCSV(mapPath)) {
+				BuildSpawnTable();
+				RestartGame();
+				LOG_INFO(LogCategory::HotReload, "%s reloaded (level restarted)", mapPath);
+			}
+			break;
+		}
+		case AssetKind::Texture:
+			if (m_assets.Reload(platform, c.path)) {
+				LOG_INFO(LogCategory::HotReload, "%s reloaded", c.path.c_str());
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
 bool Game::ReloadConfig(const char* path) {
 	GameConfig newCfg = m_cfg;
 	if (!LoadGameConfig(path, newCfg)) {
 		return false;
 	}
 
-	// Update timestamp if file exists
-	try {
-		if (std::filesystem::exists(path)) {
-			m_cfgTimestamp = std::filesystem::last_write_time(path);
-		}
+	// Apply only what changed; do NOT teleport player.
+	const uint32_t changed = DiffGameConfig(m_cfg, newCfg);
+	if (changed != 0) {
+		ApplyConfig(newCfg, changed);
 	}
-	catch (...) {}
-
-	// Apply values; respawn enemies; do NOT teleport player.
-	ApplyConfig(newCfg, true);
 	return true;
 }
 
-void Game::ApplyConfig(const GameConfig& cfg, bool respawnEnemies) {
+void Game::ApplyConfig(const GameConfig& cfg, uint32_t changed) {
 	m_cfg = cfg;
 
-	m_playerSpeed = m_cfg.playerSpeed;
-	m_enemySpeed = m_cfg.enemySpeed;
-	m_worldSize = { m_cfg.worldWidth, m_cfg.worldHeight };
+	if (changed & kConfigPlayerSpeed) m_playerSpeed = m_cfg.playerSpeed;
+	if (changed & kConfigEnemySpeed)  m_enemySpeed = m_cfg.enemySpeed;
+	if (changed & kConfigWorldSize)   m_worldSize = { m_cfg.worldWidth, m_cfg.worldHeight };
+
+	// Player spawn only matters on the next restart (m_cfg is read there).
 
-	if (respawnEnemies) {
+	if (changed & kConfigEnemySpawns) {
 		RespawnEnemiesFromConfig();
 	}
 }
 
 void Game::RespawnEnemiesFromConfig() {
-	if (m_entities.empty())
+	if (m_entities.Empty())
 		return;
 
-	// Preserve current player state (pos/prevPos/id/etc.)
-	Entity preservedPlayer = m_entities[m_playerIndex];
+	AllocScope allocScope(AllocTag::Entities);
 
-	// Rebuild entity list: player first, then enemies
-	m_entities.clear();
-	m_entities.push_back(preservedPlayer);
-	m_playerIndex = 0;
+	// Drop existing enemies; the player (and its handle) stays as-is.
+	for (size_t i = m_entities.Size(); i-- > 0;) {
+		if (m_entities[i].type == EntityType::Enemy) {
+			m_entities.Destroy(m_entities[i].id);
+		}
+	}
 
 	// Spawn enemies (ECS-lite)
 	for (const auto& sp : m_cfg.enemySpawns) {
@@ -824,6 +1122,8 @@ void Game::RespawnEnemiesFromConfig() {
 }
 
 void Game::RestartGame() {
+	AllocScope allocScope(AllocTag::Entities);
+
 	m_flowState = FlowState::Playing;
 
 	m_gameOver = false;
@@ -839,97 +1139,100 @@ void Game::RestartGame() {
 	m_shakeTime = 0.0f;
 	m_shakeDuration = 0.0f;
 
-	// Rebuild ALL entities from the CSV markers each restart.
-	m_entities.clear();
-	m_playerIndex = 0;
-	m_nextEntityId = 1;
+	// Rebuild ALL entities from the spawn table (built when the map loaded).
+	m_entities.Clear();
+	m_entities.Reserve(1 + m_spawnTable.size());
+	m_pickupByTile.clear();
+	m_pickupByTile.reserve(m_spawnPickupCount);
+	m_playerId = 0;
 
-	constexpr int kTilePlayer = 4;
-
-	// 1) Find player spawn from map (tile 4). Fallback to config if none.
-	Vec2 playerSpawn = m_cfg.playerSpawn;
-	bool foundPlayer = false;
-	for (int ty = 0; ty < m_map.Height() && !foundPlayer; ++ty) {
-		for (int tx = 0; tx < m_map.Width(); ++tx) {
-			if (m_map.At(tx, ty) == kTilePlayer) {
-				playerSpawn = m_map.TileToWorldCenter(tx, ty);
-				foundPlayer = true;
-				break;
-			}
-		}
-	}
+	// Player from the map marker; fallback to config if none.
+	const Vec2 playerSpawn = m_mapHasPlayerSpawn ? m_mapPlayerSpawn : m_cfg.playerSpawn;
 
 	// Create player
-	CreateEntity(EntityType::Player, playerSpawn, 20.0f);
-	Entity& player = m_entities[m_playerIndex];
+	Entity& player = CreateEntity(EntityType::Player, playerSpawn, 20.0f);
+	m_playerId = player.id;
 	player.health = m_playerMaxHealth;
 	player.invulnTimer = 0.0f;
 	player.invulnDuration = m_invulnSeconds;
 	player.pos = playerSpawn;
 	player.prevPos = player.pos;
 
-	// 3) Spawn pickups from map (multiple tile IDs)
-	//    2 = Token (counts toward win)
-	//    5 = Health (+1 heart)
-	//    6 = Speed (temporary speed boost)
-	//    7 = Shield (one-hit protection)
-	constexpr int kTileToken  = 2;
-	constexpr int kTileHealth = 5;
-	constexpr int kTileSpeed  = 6;
-	constexpr int kTileShield = 7;
+	// Enemies and pickups, in map scan order
+	for (const MarkerSpawn& sp : m_spawnTable) {
+		if (sp.type == EntityType::Pickup) {
+			const PickupKind kind = (PickupKind)sp.kind;
+			SpawnPickupAt(sp.pos, kind);
+			if (kind == PickupKind::Token) m_pickupsRemaining++;
+			continue;
+		}
+
+		Entity& enemy = CreateEntity(EntityType::Enemy, sp.pos, 14.0f);
+		enemy.enemyKind = (EnemyKind)sp.kind;
+		enemy.moveSpeed = 0.0f; // uses m_enemySpeed
+
+		if (enemy.enemyKind == EnemyKind::Fast) {
+			enemy.radius = 12.0f;
+			enemy.moveSpeed = m_enemySpeed * 1.6f;
+		}
+		else if (enemy.enemyKind == EnemyKind::Tank) {
+			enemy.radius = 20.0f;
+			enemy.moveSpeed = m_enemySpeed * 0.65f;
+		}
+	}
+
+	m_tokensTotal = m_pickupsRemaining;
+}
+
+void Game::BuildSpawnTable() {
+	AllocScope allocScope(AllocTag::Entities);
+
+	m_spawnTable.clear();
+	m_mapHasPlayerSpawn = false;
+	m_spawnPickupCount = 0;
 
-	m_pickupsRemaining = 0;
-	m_tokensCollected = 0;
 	for (int ty = 0; ty < m_map.Height(); ++ty) {
 		for (int tx = 0; tx < m_map.Width(); ++tx) {
 			const int tile = m_map.At(tx, ty);
-			if (tile == kTileToken || tile == kTileHealth || tile == kTileSpeed || tile == kTileShield) {
-				Vec2 center = m_map.TileToWorldCenter(tx, ty);
-				if (tile == kTileToken) {
-					SpawnPickupAt(center, PickupKind::Token);
-					m_pickupsRemaining++;
-				}
-				else if (tile == kTileHealth) {
-					SpawnPickupAt(center, PickupKind::Health);
-				}
-				else if (tile == kTileSpeed) {
-					SpawnPickupAt(center, PickupKind::Speed);
-				}
-				else if (tile == kTileShield) {
-					SpawnPickupAt(center, PickupKind::Shield);
-				}
-			}
-
-			if (tile == 3 || tile == 8 || tile == 9) {
-				Vec2 center = m_map.TileToWorldCenter(tx, ty);
+			if (tile == TileId::Floor || tile == TileId::Wall) continue;
 
-				Entity& enemy = CreateEntity(EntityType::Enemy, center, 14.0f);
-				enemy.enemyKind = EnemyKind::Chaser;
-				enemy.moveSpeed = 0.0f; // uses m_enemySpeed
+			MarkerSpawn sp;
+			sp.pos = m_map.TileToWorldCenter(tx, ty);
 
-				if (tile == 8) { // Fast
-					enemy.enemyKind = EnemyKind::Fast;
-					enemy.radius = 12.0f;
-					enemy.moveSpeed = m_enemySpeed * 1.6f;
-				}
-				else if (tile == 9) { // Tank
-					enemy.enemyKind = EnemyKind::Tank;
-					enemy.radius = 20.0f;
-					enemy.moveSpeed = m_enemySpeed * 0.65f;
+			switch (tile) {
+			case TileId::Player:
+				// First marker wins
+				if (!m_mapHasPlayerSpawn) {
+					m_mapPlayerSpawn = sp.pos;
+					m_mapHasPlayerSpawn = true;
 				}
+				continue;
+			case TileId::Token:  sp.type = EntityType::Pickup; sp.kind = (uint8_t)PickupKind::Token; break;
+			case TileId::Health: sp.type = EntityType::Pickup; sp.kind = (uint8_t)PickupKind::Health; break;
+			case TileId::Speed:  sp.type = EntityType::Pickup; sp.kind = (uint8_t)PickupKind::Speed; break;
+			case TileId::Shield: sp.type = EntityType::Pickup; sp.kind = (uint8_t)PickupKind::Shield; break;
+			case TileId::Chaser: sp.type = EntityType::Enemy; sp.kind = (uint8_t)EnemyKind::Chaser; break;
+			case TileId::Fast:   sp.type = EntityType::Enemy; sp.kind = (uint8_t)EnemyKind::Fast; break;
+			case TileId::Tank:   sp.type = EntityType::Enemy; sp.kind = (uint8_t)EnemyKind::Tank; break;
+			default: continue;
 			}
+
+			if (sp.type == EntityType::Pickup) m_spawnPickupCount++;
+			m_spawnTable.push_back(sp);
 		}
 	}
-
-	m_tokensTotal = m_pickupsRemaining;
 }
 
 void Game::SpawnPickupAt(const Vec2& worldPos, PickupKind kind)
 {
-    Entity& p = CreateEntity(EntityType::Pickup, worldPos, 12.0f);
+    Entity& p = CreateEntity(EntityType::Pickup, worldPos, kPickupRadius);
     p.active = true;
     p.pickupKind = kind;
 
+    // One pickup per marker tile; the index is the only lookup path at runtime.
+    const TileCoord t = m_map.WorldToTile(worldPos);
+    m_pickupByTile[PickupTileKey(t.x, t.y)] = p.id;
+
     // Optional per-kind value (only Token contributes to win/score)
     if (kind == PickupKind::Token) {
         p.value = 1;
@@ -938,3 +1241,160 @@ void Game::SpawnPickupAt(const Vec2& worldPos, PickupKind kind)
     }
 }
 
+
+// -----------------------------
+// Save state
+// -----------------------------
+namespace {
+	constexpr uint32_t kStateMagic = 0x5641534D;   // "MSAV"
+	constexpr uint32_t kStateVersion = 2;   // 2: flow key edge state
+
+	struct StateHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t bytes;         // whole blob, header included
+		uint32_t reserved;
+	};
+
+	// Game-level scalars as one POD section (explicit padding only).
+	struct SimRecord {
+		uint64_t tick;
+		uint32_t playerId;
+		int32_t flowState;
+		int32_t score, pickupsRemaining, tokensCollected, tokensTotal;
+		int32_t currentLevel, playerMaxHealth;
+		uint8_t gameOver, gameWin, prevKeys, pad;   // prevKeys: Return|R<<1|Escape<<2|Tab<<3
+		float invulnSeconds, hitKnockback, enemySpeed, playerSpeed;
+		float worldSize[2];
+		float shakeTime, shakeDuration, shakeStrength;
+		float speedBuffTimer, shieldTimer, debugTimer;
+		float cameraPos[2], cameraShake[2], cameraZoom;
+	};
+	static_assert(sizeof(SimRecord) == 112, "save format changed: bump kStateVersion");
+}
+
+void Game::SaveState(std::vector<uint8_t>& out) const {
+	out.clear();
+	BinaryWriter w(out);
+
+	StateHeader header{ kStateMagic, kStateVersion, 0, 0 };
+	w.Write(header);
+
+	SimRecord sim{};
+	sim.tick = m_tick;
+	sim.playerId = m_playerId;
+	sim.flowState = (int32_t)m_flowState;
+	sim.score = m_score;
+	sim.pickupsRemaining = m_pickupsRemaining;
+	sim.tokensCollected = m_tokensCollected;
+	sim.tokensTotal = m_tokensTotal;
+	sim.currentLevel = m_currentLevel;
+	sim.playerMaxHealth = m_playerMaxHealth;
+	sim.gameOver = m_gameOver ? 1 : 0;
+	sim.gameWin = m_gameWin ? 1 : 0;
+	sim.prevKeys = (uint8_t)((m_prevReturn ? 1 : 0) | (m_prevR ? 2 : 0) | (m_prevEscape ? 4 : 0) | (m_prevTab ? 8 : 0));
+	sim.invulnSeconds = m_invulnSeconds;
+	sim.hitKnockback = m_hitKnockback;
+	sim.enemySpeed = m_enemySpeed;
+	sim.playerSpeed = m_playerSpeed;
+	sim.worldSize[0] = m_worldSize.x;
+	sim.worldSize[1] = m_worldSize.y;
+	sim.shakeTime = m_shakeTime;
+	sim.shakeDuration = m_shakeDuration;
+	sim.shakeStrength = m_shakeStrength;
+	sim.speedBuffTimer = m_speedBuffTimer;
+	sim.shieldTimer = m_shieldTimer;
+	sim.debugTimer = m_debugTimer;
+	sim.cameraPos[0] = m_camera.Position().x;
+	sim.cameraPos[1] = m_camera.Position().y;
+	sim.cameraShake[0] = m_camera.ShakeOffset().x;
+	sim.cameraShake[1] = m_camera.ShakeOffset().y;
+	sim.cameraZoom = m_camera.Zoom();
+	w.Write(sim);
+
+	m_map.Save(w);
+	m_entities.Save(w);
+
+	header.bytes = (uint32_t)w.Size();
+	w.Patch(0, header);
+}
+
+bool Game::LoadState(const std::vector<uint8_t>& data) {
+	AllocScope allocScope(AllocTag::Entities);
+
+	BinaryReader r(data.data(), data.size());
+
+	StateHeader header{};
+	if (!r.Read(header) || header.magic != kStateMagic) {
+		LOG_WARN(LogCategory::Game, "Save state: not a state blob");
+		return false;
+	}
+	if (header.version != kStateVersion || header.bytes != data.size()) {
+		LOG_WARN(LogCategory::Game, "Save state: version %u / %u bytes, expected version %u / %zu bytes",
+			header.version, header.bytes, kStateVersion, data.size());
+		return false;
+	}
+
+	// Parse everything into temporaries first so a bad blob changes nothing.
+	SimRecord sim{};
+	Tilemap map;
+	EntityPool entities;
+	if (!r.Read(sim) || !map.Load(r) || !entities.Load(r) || !r.AtEnd() ||
+		sim.flowState < (int32_t)FlowState::Playing || sim.flowState > (int32_t)FlowState::QuitConfirm ||
+		!entities.Alive(sim.playerId)) {
+		LOG_WARN(LogCategory::Game, "Save state: malformed data");
+		return false;
+	}
+
+	m_map = std::move(map);
+	m_entities = std::move(entities);
+
+	m_tick = sim.tick;
+	m_playerId = sim.playerId;
+	m_flowState = (FlowState)sim.flowState;
+	m_score = sim.score;
+	m_pickupsRemaining = sim.pickupsRemaining;
+	m_tokensCollected = sim.tokensCollected;
+	m_tokensTotal = sim.tokensTotal;
+	m_currentLevel = sim.currentLevel;
+	m_playerMaxHealth = sim.playerMaxHealth;
+	m_gameOver = sim.gameOver != 0;
+	m_gameWin = sim.gameWin != 0;
+	m_prevReturn = (sim.prevKeys & 1) != 0;
+	m_prevR = (sim.prevKeys & 2) != 0;
+	m_prevEscape = (sim.prevKeys & 4) != 0;
+	m_prevTab = (sim.prevKeys & 8) != 0;
+	m_invulnSeconds = sim.invulnSeconds;
+	m_hitKnockback = sim.hitKnockback;
+	m_enemySpeed = sim.enemySpeed;
+	m_playerSpeed = sim.playerSpeed;
+	m_worldSize = { sim.worldSize[0], sim.worldSize[1] };
+	m_shakeTime = sim.shakeTime;
+	m_shakeDuration = sim.shakeDuration;
+	m_shakeStrength = sim.shakeStrength;
+	m_speedBuffTimer = sim.speedBuffTimer;
+	m_shieldTimer = sim.shieldTimer;
+	m_debugTimer = sim.debugTimer;
+	m_camera.SetPosition({ sim.cameraPos[0], sim.cameraPos[1] });
+	m_camera.SetShakeOffset({ sim.cameraShake[0], sim.cameraShake[1] });
+	m_camera.SetZoom(sim.cameraZoom);
+
+	// Derived data: spawn table from the map, pickup index from the pickups.
+	BuildSpawnTable();
+	m_pickupByTile.clear();
+	for (const Entity& e : m_entities) {
+		if (e.type != EntityType::Pickup) continue;
+		const TileCoord t = m_map.WorldToTile(e.pos);
+		m_pickupByTile[PickupTileKey(t.x, t.y)] = e.id;
+	}
+
+	PublishRenderSnapshot();
+	return true;
+}
+
+uint64_t Game::ComputeStateHash() const {
+	// The save blob has no padding or pointers, so hashing it covers the full
+	// simulation state (map included) with no per-field code to keep in sync.
+	SaveState(m_hashScratch);
+	return HashBytes(m_hashScratch.data(), m_hashScratch.size());
+}
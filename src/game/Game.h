@@ -1,15 +1,20 @@
 #pragma once
 #include "engine/Assets.h"
+#include "engine/AssetWatcher.h"
 #include "engine/Camera2D.h"
 #include "engine/Config.h"
 #include "engine/Input.h"
 #include "engine/Math.h"
 #include "game/Entity.h"
+#include "game/EntityPool.h"
 #include "engine/DebugState.h"
 #include "game/Tilemap.h"
-#include <filesystem>
+#include "game/RenderSnapshot.h"
+#include "engine/TripleBuffer.h"
+#include "engine/FrameArena.h"
+#include "game/SpatialGrid.h"
+#include <unordered_map>
 #include <vector>
-using EntityId = uint32_t;
 class SdlPlatform;
 
 /**
@@ -20,18 +25,55 @@ class Game {
 public:
     bool Init(SdlPlatform& platform);
 
-    // Fixed-step simulation update.
+    // Fixed-step simulation update. Publishes a render snapshot at the end of each step.
     void Update(SdlPlatform& platform, const Input& input, float fixedDt, DebugState& dbg);
+
+    // Draws the latest published snapshot (never touches live entities).
     void Render(SdlPlatform& platform, float alpha, const DebugState& dbg);
     
     bool RequestedQuit() const { return m_requestQuit; }
 
+    // Replaces the current level (e.g. a generated map) and restarts on it.
+    void LoadMap(const Tilemap& map);
+    // Restarts the current level (same as R on the lose screen).
+    void Restart();
+    const Tilemap& Map() const { return m_map; }
+
+    // Whole simulation (map, entities, timers, flow, camera) as a versioned
+    // binary blob. SaveState overwrites out; reuse the vector to keep its
+    // capacity when checkpointing often. LoadState leaves the game
+    // untouched if the blob is malformed or from another version.
+    void SaveState(std::vector<uint8_t>& out) const;
+    bool LoadState(const std::vector<uint8_t>& data);
+
+    // Hash of everything SaveState writes. Two runs with the same inputs and
+    // view size must produce the same hash every tick (deterministic mode).
+    uint64_t ComputeStateHash() const;
+
+    // False on the win/lose/quit screens, where the simulation is paused.
+    bool IsPlaying() const;
+    bool IsWon() const;
+    int TokensCollected() const { return m_tokensCollected; }
+
+    // Applies a config file over the current one (unchanged fields keep their
+    // values). Also used for hot reload; false if the file can't be parsed.
+    bool ReloadConfig(const char* path);
+
+    // Applies hot-reloaded assets and the debug UI's manual config reload.
+    // Call once per frame, outside the fixed step.
+    void ProcessAssetChanges(SdlPlatform& platform, DebugState& dbg);
+
 private:
     void ClampPlayerToWorld(Entity& player) const;
+    Vec2 WorldExtent() const;   // configured world, grown to fit the map
     void UpdateCameraFollow(SdlPlatform& platform, const Entity& player);
-    void DrawWorldGrid(SdlPlatform& platform) const;
+    void DrawWorldGrid(SdlPlatform& platform, const Camera2D& cam) const;
     void RestartGame();
 
+    void Step(SdlPlatform& platform, const Input& input, float fixedDt, DebugState& dbg);
+    void PublishRenderSnapshot();
+    void PrepareDrawList(const RenderSnapshot& snap, float alpha, bool showPaths, int viewW, int viewH);
+
 private:
     Assets     m_assets;
     GameConfig m_cfg;
@@ -45,8 +87,50 @@ private:
     float m_hitKnockback = 280.0f;
     float m_invulnSeconds = 0.75f;
 
-    std::vector<Entity> m_entities;
-    int m_playerIndex = -1;
+    EntityPool m_entities;
+    EntityId m_playerId = 0;
+
+    Entity& Player() { return *m_entities.Get(m_playerId); }
+
+    // Entity inspector rows, built on demand from the pool
+    class InspectorSource final : public DebugEntitySource {
+    public:
+        explicit InspectorSource(const EntityPool& pool) : m_pool(pool) {}
+        int EntityCount() const override;
+        bool EntityRow(int index, DebugState::EntityDebugRow& out) const override;
+        bool FindEntity(uint32_t id, DebugState::EntityDebugRow& out) const override;
+    private:
+        const EntityPool& m_pool;
+    };
+    InspectorSource m_inspector{ m_entities };
+
+    // Render snapshots (simulation writes, Render reads)
+    TripleBuffer<RenderSnapshot> m_snapshots;
+    uint64_t m_tick = 0;
+
+    // Visible set: live entities inside the camera view (plus margin). The
+    // grid is rebuilt on every query because dense indices move whenever
+    // entities are created or destroyed.
+    static constexpr float kGridCellSize = 128.0f;
+    static constexpr float kViewMarginPx = 64.0f;
+    SpatialGrid m_grid;
+    std::vector<uint32_t> m_visibleSet;     // dense indices, pool order
+    std::vector<uint8_t> m_isVisible;       // per dense index (AI LOD)
+    int m_viewW = 0;                        // last known view size
+    int m_viewH = 0;
+    void QueryVisibleSet();
+
+    // Render prep output (render thread only), reused every frame
+    std::vector<Vec2> m_screenPos;      // per snapshot entity, interpolated
+    std::vector<Vec2> m_screenPath;     // per snapshot path point
+    std::vector<DrawPrim> m_drawList;
+
+    // Per-tick transient memory (A* scratch etc.), swapped once per fixed step.
+    // Grown per map: one A* search needs ~9 bytes per tile (g, parent, closed)
+    // plus the open list and the path, which the base size covers.
+    static constexpr size_t kFrameArenaBytes = 256 * 1024;
+    static constexpr size_t kFrameArenaBytesPerTile = 10;
+    DoubleBufferedArena m_frameArena;
 
     float m_debugTimer = 0.0f;
 
@@ -64,20 +148,31 @@ private:
     float m_shieldTimer = 0.0f;
     float m_shieldDuration = 2.5f;
 
-    std::filesystem::file_time_type m_cfgTimestamp{};
-    float m_cfgPollTimer = 0.0f;
+    AssetWatcher m_assetWatcher;
+    std::vector<AssetChange> m_assetChanges;
 
     float m_enemySpeed = 120.0f;
 
-    bool ReloadConfig(const char* path);
-    void ApplyConfig(const GameConfig& cfg, bool respawnEnemies);
+    void ApplyConfig(const GameConfig& cfg, uint32_t changed); // ConfigChange bits
     void RespawnEnemiesFromConfig();
 
-    EntityId m_nextEntityId = 1;
     Entity& CreateEntity(EntityType type, Vec2 pos, float radius);
 
     Tilemap m_map;
 
+    // Spawn markers pulled out of m_map once per map load (scan order), so a
+    // restart is one linear pass: no map scan, no pool reallocation.
+    struct MarkerSpawn {
+        Vec2 pos;
+        EntityType type = EntityType::Enemy;
+        uint8_t kind = 0;           // EnemyKind or PickupKind
+    };
+    std::vector<MarkerSpawn> m_spawnTable;
+    Vec2 m_mapPlayerSpawn{ 0.0f, 0.0f };
+    bool m_mapHasPlayerSpawn = false;
+    size_t m_spawnPickupCount = 0;
+    void BuildSpawnTable();
+
     bool m_gameOver = false;
     int  m_score = 0;
     int  m_pickupsRemaining = 0;
@@ -85,12 +180,25 @@ private:
 
     void SpawnPickupAt(const Vec2& worldPos, PickupKind kind);
 
+    // Sparse tile -> pickup index, built at spawn time (pickups never move).
+    static constexpr float kPickupRadius = 12.0f;
+    static int64_t PickupTileKey(int tx, int ty) { return ((int64_t)ty << 32) | (uint32_t)tx; }
+    std::unordered_map<int64_t, EntityId> m_pickupByTile;
+
     int m_tokensCollected = 0;
     int m_tokensTotal = 0;
 
     int m_currentLevel = 1;
 
     bool m_requestQuit = false;
+
+    // Key state from the previous step, for edge-triggered flow keys
+    bool m_prevReturn = false;
+    bool m_prevR = false;
+    bool m_prevEscape = false;
+    bool m_prevTab = false;
+
+    mutable std::vector<uint8_t> m_hashScratch;   // reused by ComputeStateHash
     
     enum class FlowState { Playing, Win, Lose, QuitConfirm };
     FlowState m_flowState = FlowState::Playing;
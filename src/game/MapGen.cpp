@@ -0,0 +1,277 @@
+#include "game/MapGen.h"
+#include "game/Tilemap.h"
+#include "engine/Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+    // Working grid: only Floor/Wall until markers are placed.
+    struct Grid {
+        int w = 0;
+        int h = 0;
+        std::vector<int> tiles;
+
+        Grid(int width, int height, int fill) : w(width), h(height), tiles((size_t)width * (size_t)height, fill) {}
+
+        bool Inside(int x, int y) const { return x >= 0 && y >= 0 && x < w && y < h; }
+        int& At(int x, int y) { return tiles[(size_t)y * (size_t)w + (size_t)x]; }
+        int Get(int x, int y) const { return Inside(x, y) ? tiles[(size_t)y * (size_t)w + (size_t)x] : TileId::Wall; }
+    };
+
+    // Recursive backtracker on odd coordinates, iterative so big mazes can't
+    // overflow the stack.
+    void CarveMaze(Grid& g, Rng& rng, float loopChance) {
+        static const int kDirs[4][2] = { { 2, 0 }, { -2, 0 }, { 0, 2 }, { 0, -2 } };
+
+        std::vector<int> stack;
+        stack.reserve((size_t)(g.w / 2) * (size_t)(g.h / 2));
+        g.At(1, 1) = TileId::Floor;
+        stack.push_back(g.w + 1);
+
+        while (!stack.empty()) {
+            const int cx = stack.back() % g.w;
+            const int cy = stack.back() / g.w;
+
+            int options[4];
+            int count = 0;
+            for (int d = 0; d < 4; ++d) {
+                const int nx = cx + kDirs[d][0];
+                const int ny = cy + kDirs[d][1];
+                if (nx >= 1 && ny >= 1 && nx <= g.w - 2 && ny <= g.h - 2 && g.At(nx, ny) == TileId::Wall) {
+                    options[count++] = d;
+                }
+            }
+            if (count == 0) {
+                stack.pop_back();
+                continue;
+            }
+
+            const int d = options[rng.Range(count)];
+            const int nx = cx + kDirs[d][0];
+            const int ny = cy + kDirs[d][1];
+            g.At(cx + kDirs[d][0] / 2, cy + kDirs[d][1] / 2) = TileId::Floor;
+            g.At(nx, ny) = TileId::Floor;
+            stack.push_back(ny * g.w + nx);
+        }
+
+        // A perfect maze has exactly one route everywhere; open a few walls
+        // between corridors so enemies have alternatives to path around.
+        if (loopChance <= 0.0f) return;
+        for (int y = 1; y < g.h - 1; ++y) {
+            for (int x = 1; x < g.w - 1; ++x) {
+                if (g.At(x, y) != TileId::Wall) continue;
+                const bool horizontal = g.Get(x - 1, y) == TileId::Floor && g.Get(x + 1, y) == TileId::Floor;
+                const bool vertical = g.Get(x, y - 1) == TileId::Floor && g.Get(x, y + 1) == TileId::Floor;
+                if ((horizontal || vertical) && rng.Chance(loopChance)) {
+                    g.At(x, y) = TileId::Floor;
+                }
+            }
+        }
+    }
+
+    // Random fill + smoothing (a tile becomes wall with >= 5 walls in its 3x3).
+    void GrowCave(Grid& g, Rng& rng, float fill, int passes) {
+        for (int y = 1; y < g.h - 1; ++y) {
+            for (int x = 1; x < g.w - 1; ++x) {
+                g.At(x, y) = rng.Chance(fill) ? TileId::Wall : TileId::Floor;
+            }
+        }
+
+        Grid next = g;
+        for (int pass = 0; pass < passes; ++pass) {
+            for (int y = 1; y < g.h - 1; ++y) {
+                for (int x = 1; x < g.w - 1; ++x) {
+                    int walls = 0;
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            if (g.Get(x + dx, y + dy) == TileId::Wall) ++walls;
+                        }
+                    }
+                    next.At(x, y) = (walls >= 5) ? TileId::Wall : TileId::Floor;
+                }
+            }
+            std::swap(g.tiles, next.tiles);
+        }
+    }
+
+    // Open floor with scattered 1..3 tile pillars.
+    void BuildArena(Grid& g, Rng& rng, float pillars) {
+        for (int y = 1; y < g.h - 1; ++y) {
+            for (int x = 1; x < g.w - 1; ++x) {
+                g.At(x, y) = TileId::Floor;
+            }
+        }
+        for (int y = 2; y < g.h - 2; ++y) {
+            for (int x = 2; x < g.w - 2; ++x) {
+                if (!rng.Chance(pillars)) continue;
+                const int pw = 1 + rng.Range(3);
+                const int ph = 1 + rng.Range(3);
+                for (int py = y; py < std::min(y + ph, g.h - 2); ++py) {
+                    for (int px = x; px < std::min(x + pw, g.w - 2); ++px) {
+                        g.At(px, py) = TileId::Wall;
+                    }
+                }
+            }
+        }
+    }
+
+    // Walls off every floor region except the largest (4-connected) and
+    // returns its tiles, so every marker is reachable from the player.
+    std::vector<int> KeepLargestRegion(Grid& g) {
+        std::vector<int> label(g.tiles.size(), -1);
+        std::vector<int> queue;
+        queue.reserve(g.tiles.size());
+
+        int best = -1;
+        size_t bestSize = 0;
+        int regions = 0;
+
+        for (size_t start = 0; start < g.tiles.size(); ++start) {
+            if (g.tiles[start] != TileId::Floor || label[start] >= 0) continue;
+
+            queue.clear();
+            queue.push_back((int)start);
+            label[start] = regions;
+            for (size_t head = 0; head < queue.size(); ++head) {
+                const int x = queue[head] % g.w;
+                const int y = queue[head] / g.w;
+                const int next[4][2] = { { x + 1, y }, { x - 1, y }, { x, y + 1 }, { x, y - 1 } };
+                for (const auto& n : next) {
+                    if (g.Get(n[0], n[1]) != TileId::Floor) continue;
+                    const size_t i = (size_t)n[1] * (size_t)g.w + (size_t)n[0];
+                    if (label[i] >= 0) continue;
+                    label[i] = regions;
+                    queue.push_back((int)i);
+                }
+            }
+            if (queue.size() > bestSize) {
+                bestSize = queue.size();
+                best = regions;
+            }
+            ++regions;
+        }
+
+        std::vector<int> floor;
+        floor.reserve(bestSize);
+        for (size_t i = 0; i < g.tiles.size(); ++i) {
+            if (g.tiles[i] != TileId::Floor) continue;
+            if (label[i] == best) floor.push_back((int)i);
+            else g.tiles[i] = TileId::Wall;
+        }
+        return floor;
+    }
+
+    void PlaceMarkers(Grid& g, Rng& rng, const MapGenParams& p, std::vector<int>& floor) {
+        // Player: reachable tile closest to the map centre.
+        const float cx = (g.w - 1) * 0.5f;
+        const float cy = (g.h - 1) * 0.5f;
+        size_t playerSlot = 0;
+        float bestDist = 1e30f;
+        for (size_t i = 0; i < floor.size(); ++i) {
+            const float dx = (float)(floor[i] % g.w) - cx;
+            const float dy = (float)(floor[i] / g.w) - cy;
+            const float d = dx * dx + dy * dy;
+            if (d < bestDist) {
+                bestDist = d;
+                playerSlot = i;
+            }
+        }
+        const int player = floor[playerSlot];
+        g.tiles[(size_t)player] = TileId::Player;
+        floor[playerSlot] = floor.back();
+        floor.pop_back();
+
+        for (size_t i = floor.size(); i > 1; --i) {
+            std::swap(floor[i - 1], floor[(size_t)rng.Range((int)i)]);
+        }
+
+        const float floorCount = (float)floor.size();
+        const int enemies = (int)std::lround(std::max(0.0f, p.enemyDensity) * floorCount);
+        const int pickups = (int)std::lround(std::max(0.0f, p.pickupDensity) * floorCount);
+        const int tokens = std::max(1, p.tokens);
+
+        // Enemies first, skipping the safe zone around the player.
+        const int px = player % g.w;
+        const int py = player / g.w;
+        const int safeSq = p.safeRadius * p.safeRadius;
+        int placed = 0;
+        for (size_t i = 0; i < floor.size() && placed < enemies; ++i) {
+            const int dx = floor[i] % g.w - px;
+            const int dy = floor[i] / g.w - py;
+            if (dx * dx + dy * dy <= safeSq) continue;
+
+            const float u = rng.Unit();
+            int tile = TileId::Chaser;
+            if (u < p.fastShare) tile = TileId::Fast;
+            else if (u < p.fastShare + p.tankShare) tile = TileId::Tank;
+            g.tiles[(size_t)floor[i]] = tile;
+            ++placed;
+        }
+
+        // Pickups on whatever is still free.
+        static const int kPickupKinds[3] = { TileId::Health, TileId::Speed, TileId::Shield };
+        int tokensPlaced = 0;
+        int pickupsPlaced = 0;
+        for (size_t i = 0; i < floor.size() && (tokensPlaced < tokens || pickupsPlaced < pickups); ++i) {
+            int& tile = g.tiles[(size_t)floor[i]];
+            if (tile != TileId::Floor) continue;
+            if (tokensPlaced < tokens) {
+                tile = TileId::Token;
+                ++tokensPlaced;
+            }
+            else {
+                tile = kPickupKinds[pickupsPlaced % 3];
+                ++pickupsPlaced;
+            }
+        }
+    }
+}
+
+namespace MapGen {
+    bool Generate(const MapGenParams& params, Tilemap& out) {
+        if (params.width < 5 || params.height < 5) return false;
+
+        Rng rng(params.seed);
+        Grid g(params.width, params.height, TileId::Wall);
+
+        switch (params.layout) {
+        case MapLayout::Maze:  CarveMaze(g, rng, params.mazeLoopChance); break;
+        case MapLayout::Cave:  GrowCave(g, rng, params.caveFill, params.caveSmoothing); break;
+        case MapLayout::Arena: BuildArena(g, rng, params.arenaPillars); break;
+        }
+
+        std::vector<int> floor = KeepLargestRegion(g);
+        if (floor.empty()) return false;
+        PlaceMarkers(g, rng, params, floor);
+
+        out.Resize(g.w, g.h, TileId::Wall);
+        for (int y = 0; y < g.h; ++y) {
+            for (int x = 0; x < g.w; ++x) {
+                out.SetAt(x, y, g.At(x, y));
+            }
+        }
+        return true;
+    }
+
+    const char* LayoutName(MapLayout layout) {
+        switch (layout) {
+        case MapLayout::Maze:  return "maze";
+        case MapLayout::Cave:  return "cave";
+        case MapLayout::Arena: return "arena";
+        }
+        return "?";
+    }
+
+    bool ParseLayout(const char* name, MapLayout& out) {
+        for (MapLayout l : { MapLayout::Maze, MapLayout::Cave, MapLayout::Arena }) {
+            if (std::strcmp(name, LayoutName(l)) == 0) {
+                out = l;
+                return true;
+            }
+        }
+        return false;
+    }
+}
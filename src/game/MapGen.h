@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+class Tilemap;
+
+enum class MapLayout : uint8_t { Maze, Cave, Arena };
+
+/**
+ * Parameters for a procedurally generated level in the CSV tile format.
+ * Densities are fractions of the reachable floor tiles; the same params
+ * and seed always produce the same map.
+ */
+struct MapGenParams {
+    MapLayout layout = MapLayout::Maze;
+    int width = 64;
+    int height = 64;
+    uint32_t seed = 1;
+
+    float enemyDensity = 0.02f;     // markers 3/8/9
+    float fastShare = 0.25f;        // of enemies: 8 (Fast)
+    float tankShare = 0.15f;        // of enemies: 9 (Tank); the rest are 3 (Chaser)
+    float pickupDensity = 0.01f;    // markers 5/6/7, split evenly
+    int tokens = 8;                 // markers 2 (at least one is always placed)
+    int safeRadius = 6;             // tiles around the player kept free of enemies
+
+    float mazeLoopChance = 0.05f;   // extra wall knock-outs so mazes have cycles
+    float caveFill = 0.45f;         // initial wall probability
+    int caveSmoothing = 5;          // cellular automaton passes
+    float arenaPillars = 0.03f;     // pillar seeds per interior tile
+};
+
+namespace MapGen {
+    // Fills out with a walled map whose floor is a single connected region,
+    // with one player marker (4) and the requested spawn markers.
+    // Returns false if the size is too small to hold a level (< 5x5).
+    bool Generate(const MapGenParams& params, Tilemap& out);
+
+    const char* LayoutName(MapLayout layout);
+    bool ParseLayout(const char* name, MapLayout& out);
+}
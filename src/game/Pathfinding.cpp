@@ -1,10 +1,16 @@
 #include "game/Pathfinding.h"
 #include "game/Tilemap.h"
+#include "engine/Profiler.h"
+#include "engine/Counters.h"
 #include <queue>
 #include <vector>
 #include <limits>
 #include <cstdlib>
 #include <algorithm>
+#include <memory>
+
+static Counter s_astarCalls("astar.calls");
+static Counter s_astarExpanded("astar.expanded");
 
 static int manhattan(TileCoord a, TileCoord b) {
     return std::abs(a.x - b.x) + std::abs(a.y - b.y);
@@ -22,81 +28,112 @@ struct NodeCmp {
 static int flatten(int x, int y, int w) { return y * w + x; }
 static TileCoord unflatten(int idx, int w) { return TileCoord{ idx % w, idx / w }; }
 
-namespace Pathfinding {
+// Shared search. Alloc is the allocator used for all scratch storage (rebound
+// per element type); out must already use a compatible allocator.
+template <typename Alloc, typename OutVec>
+static void AStarImpl(const Tilemap& map, TileCoord start, TileCoord goal, int maxNodesExpanded,
+    const Alloc& alloc, OutVec& out) {
+    using Traits = std::allocator_traits<Alloc>;
+    using IntAlloc = typename Traits::template rebind_alloc<int>;
+    using ByteAlloc = typename Traits::template rebind_alloc<uint8_t>;
+    using NodeAlloc = typename Traits::template rebind_alloc<Node>;
 
-    std::vector<TileCoord> AStar(const Tilemap& map, TileCoord start, TileCoord goal, int maxNodesExpanded) {
-        std::vector<TileCoord> out;
+    PROFILE_ZONE("AStar");
+    s_astarCalls.Add();
 
-        const int w = map.Width();
-        const int h = map.Height();
-        if (w <= 0 || h <= 0) return out;
+    const int w = map.Width();
+    const int h = map.Height();
+    if (w <= 0 || h <= 0) return;
 
-        auto inBounds = [&](int x, int y) { return x >= 0 && y >= 0 && x < w && y < h; };
+    auto inBounds = [&](int x, int y) { return x >= 0 && y >= 0 && x < w && y < h; };
 
-        if (!inBounds(start.x, start.y) || !inBounds(goal.x, goal.y)) return out;
-        if (map.IsSolidTile(start.x, start.y) || map.IsSolidTile(goal.x, goal.y)) return out;
+    if (!inBounds(start.x, start.y) || !inBounds(goal.x, goal.y)) return;
+    if (map.IsSolidTile(start.x, start.y) || map.IsSolidTile(goal.x, goal.y)) return;
 
-        const int N = w * h;
-        const int INF = std::numeric_limits<int>::max() / 4;
+    const int N = w * h;
+    const int INF = std::numeric_limits<int>::max() / 4;
 
-        std::vector<int> g(N, INF);
-        std::vector<int> parent(N, -1);
-        std::vector<uint8_t> closed(N, 0);
+    std::vector<int, IntAlloc> g(N, INF, IntAlloc(alloc));
+    std::vector<int, IntAlloc> parent(N, -1, IntAlloc(alloc));
+    std::vector<uint8_t, ByteAlloc> closed(N, 0, ByteAlloc(alloc));
 
-        const int sIdx = flatten(start.x, start.y, w);
-        const int gIdx = flatten(goal.x, goal.y, w);
+    const int sIdx = flatten(start.x, start.y, w);
+    const int gIdx = flatten(goal.x, goal.y, w);
 
-        g[sIdx] = 0;
+    g[sIdx] = 0;
 
-        std::priority_queue<Node, std::vector<Node>, NodeCmp> open;
-        open.push(Node{ sIdx, manhattan(start, goal) });
+    // Pre-size the heap so it rarely regrows (regrowth strands memory in an arena).
+    std::vector<Node, NodeAlloc> openStorage{ NodeAlloc(alloc) };
+    openStorage.reserve((size_t)std::min(N, 256));
+    std::priority_queue<Node, std::vector<Node, NodeAlloc>, NodeCmp> open(NodeCmp{}, std::move(openStorage));
+    open.push(Node{ sIdx, manhattan(start, goal) });
 
-        int expanded = 0;
+    int expanded = 0;
 
-        const int dirs[4][2] = { {1,0},{-1,0},{0,1},{0,-1} };
+    const int dirs[4][2] = { {1,0},{-1,0},{0,1},{0,-1} };
 
-        while (!open.empty()) {
-            Node cur = open.top();
-            open.pop();
+    while (!open.empty()) {
+        Node cur = open.top();
+        open.pop();
 
-            if (closed[cur.idx]) continue;
-            closed[cur.idx] = 1;
+        if (closed[cur.idx]) continue;
+        closed[cur.idx] = 1;
 
-            TileCoord c = unflatten(cur.idx, w);
-            if (cur.idx == gIdx) break;
+        TileCoord c = unflatten(cur.idx, w);
+        if (cur.idx == gIdx) break;
 
-            if (++expanded > maxNodesExpanded) break;
+        if (++expanded > maxNodesExpanded) break;
 
-            for (auto& d : dirs) {
-                int nx = c.x + d[0];
-                int ny = c.y + d[1];
-                if (!inBounds(nx, ny)) continue;
-                if (map.IsSolidTile(nx, ny)) continue;
+        for (auto& d : dirs) {
+            int nx = c.x + d[0];
+            int ny = c.y + d[1];
+            if (!inBounds(nx, ny)) continue;
+            if (map.IsSolidTile(nx, ny)) continue;
 
-                int nIdx = flatten(nx, ny, w);
-                if (closed[nIdx]) continue;
+            int nIdx = flatten(nx, ny, w);
+            if (closed[nIdx]) continue;
 
-                int tentativeG = g[cur.idx] + 1;
-                if (tentativeG < g[nIdx]) {
-                    g[nIdx] = tentativeG;
-                    parent[nIdx] = cur.idx;
-                    int f = tentativeG + manhattan(TileCoord{ nx, ny }, goal);
-                    open.push(Node{ nIdx, f });
-                }
+            int tentativeG = g[cur.idx] + 1;
+            if (tentativeG < g[nIdx]) {
+                g[nIdx] = tentativeG;
+                parent[nIdx] = cur.idx;
+                int f = tentativeG + manhattan(TileCoord{ nx, ny }, goal);
+                open.push(Node{ nIdx, f });
             }
         }
+    }
 
-        // Reconstruct
-        if (parent[gIdx] == -1 && gIdx != sIdx) return out;
+    s_astarExpanded.Add(expanded);
 
-        int walk = gIdx;
-        out.push_back(unflatten(walk, w));
-        while (walk != sIdx) {
-            walk = parent[walk];
-            if (walk < 0) { out.clear(); return out; }
-            out.push_back(unflatten(walk, w));
-        }
-        std::reverse(out.begin(), out.end());
+    // Reconstruct
+    if (parent[gIdx] == -1 && gIdx != sIdx) return;
+
+    int len = 1;
+    for (int walk = gIdx; walk != sIdx; walk = parent[walk]) {
+        if (parent[walk] < 0) return;
+        ++len;
+    }
+
+    out.resize((size_t)len);
+    int walk = gIdx;
+    for (int i = len - 1; i >= 0; --i) {
+        out[(size_t)i] = unflatten(walk, w);
+        walk = parent[walk];
+    }
+}
+
+namespace Pathfinding {
+
+    std::vector<TileCoord> AStar(const Tilemap& map, TileCoord start, TileCoord goal, int maxNodesExpanded) {
+        std::vector<TileCoord> out;
+        AStarImpl(map, start, goal, maxNodesExpanded, std::allocator<TileCoord>(), out);
+        return out;
+    }
+
+    ArenaVector<TileCoord> AStar(const Tilemap& map, TileCoord start, TileCoord goal,
+        LinearArena& arena, int maxNodesExpanded) {
+        ArenaVector<TileCoord> out{ ArenaAllocator<TileCoord>(arena) };
+        AStarImpl(map, start, goal, maxNodesExpanded, ArenaAllocator<TileCoord>(arena), out);
         return out;
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <cstdint>
+#include "engine/FrameArena.h"
 
 struct TileCoord {
     int x = 0;
@@ -14,4 +15,10 @@ namespace Pathfinding {
     // Returns path INCLUDING start and goal tiles if found. Empty = no path.
     std::vector<TileCoord> AStar(const Tilemap& map, TileCoord start, TileCoord goal,
         int maxNodesExpanded = 4000);
+
+    // Same search, but every scratch buffer and the result are carved from
+    // arena: no heap traffic per call. The result dies on the arena's next Reset()
+    // (or Rewind past it; wrap the call in an ArenaScope to free its scratch).
+    ArenaVector<TileCoord> AStar(const Tilemap& map, TileCoord start, TileCoord goal,
+        LinearArena& arena, int maxNodesExpanded = 4000);
 }
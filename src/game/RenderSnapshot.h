@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "engine/Camera2D.h"
+#include "engine/Math.h"
+
+/**
+ * Immutable view of the world produced once per fixed step.
+ * Render only reads this, never the live entity list, so simulation and
+ * presentation can run at their own pace.
+ */
+enum class RenderKind : uint8_t { Player, Enemy, Pickup };
+
+struct RenderEntity {
+    Vec2 pos{ 0,0 };
+    Vec2 prevPos{ 0,0 };
+    float radius = 0.0f;
+
+    RenderKind kind = RenderKind::Enemy;
+    uint8_t r = 255, g = 255, b = 255;
+    bool visible = true;        // false while the player blinks
+
+    // Remaining path polyline in RenderSnapshot::pathPoints (enemies only)
+    uint32_t pathBegin = 0;
+    uint32_t pathCount = 0;
+};
+
+/**
+ * Screen-space primitive built from a snapshot by Game's render prep pass
+ * (already interpolated, transformed and culled); drawing walks these in order.
+ */
+struct DrawPrim {
+    enum class Type : uint8_t { Sprite, Rect, Line };
+
+    Type type = Type::Rect;
+    uint8_t r = 255, g = 255, b = 255;
+    int x = 0, y = 0;   // Sprite/Rect: top-left; Line: start
+    int w = 0, h = 0;   // Sprite/Rect: size; Line: end
+};
+
+enum class RenderFlow : uint8_t { Playing, Win, Lose, QuitConfirm };
+
+struct RenderSnapshot {
+    uint64_t tick = 0;
+    bool valid = false;
+
+    Camera2D camera;
+
+    std::vector<RenderEntity> entities;
+    std::vector<Vec2> pathPoints;
+
+    // HUD
+    int playerHealth = 0;
+    int playerMaxHealth = 1;
+    int tokensCollected = 0;
+    int tokensTotal = 0;
+    bool speedBuff = false;
+    bool shield = false;
+    RenderFlow flow = RenderFlow::Playing;
+};
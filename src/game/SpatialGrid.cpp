@@ -0,0 +1,60 @@
+#include "game/SpatialGrid.h"
+#include "game/EntityPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+int SpatialGrid::CellX(float x) const {
+    return std::clamp((int)std::floor(x / m_cellSize), 0, m_cellsW - 1);
+}
+
+int SpatialGrid::CellY(float y) const {
+    return std::clamp((int)std::floor(y / m_cellSize), 0, m_cellsH - 1);
+}
+
+void SpatialGrid::Build(const EntityPool& pool, const Vec2& worldSize, float cellSize) {
+    m_cellSize = std::max(1.0f, cellSize);
+    m_cellsW = std::max(1, (int)std::ceil(worldSize.x / m_cellSize));
+    m_cellsH = std::max(1, (int)std::ceil(worldSize.y / m_cellSize));
+
+    const size_t cellCount = (size_t)m_cellsW * (size_t)m_cellsH;
+    const size_t count = pool.Size();
+    m_cellStart.assign(cellCount + 1, 0);
+    m_cellOf.resize(count);
+    m_items.resize(count);
+
+    // Count per cell, prefix-sum into offsets, then scatter in pool order
+    for (size_t i = 0; i < count; ++i) {
+        const Vec2& p = pool[i].pos;
+        const uint32_t cell = (uint32_t)(CellY(p.y) * m_cellsW + CellX(p.x));
+        m_cellOf[i] = cell;
+        m_cellStart[cell + 1]++;
+    }
+    for (size_t c = 0; c < cellCount; ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+    m_cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        m_items[m_cursor[m_cellOf[i]]++] = (uint32_t)i;
+    }
+}
+
+void SpatialGrid::Query(const EntityPool& pool, const Aabb& area, std::vector<uint32_t>& out) const {
+    if (m_items.empty() || area.max.x < area.min.x || area.max.y < area.min.y) return;
+
+    const size_t first = out.size();
+    const int x0 = CellX(area.min.x), x1 = CellX(area.max.x);
+    const int y0 = CellY(area.min.y), y1 = CellY(area.max.y);
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            const uint32_t cell = (uint32_t)(cy * m_cellsW + cx);
+            for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+                const uint32_t i = m_items[k];
+                if (area.Contains(pool[i].pos)) out.push_back(i);
+            }
+        }
+    }
+
+    // Cells are visited row by row; callers want pool (draw/update) order.
+    std::sort(out.begin() + (ptrdiff_t)first, out.end());
+}
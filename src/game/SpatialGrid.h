@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "engine/Math.h"
+
+class EntityPool;
+
+/**
+ * Uniform grid over the entity pool's dense indices.
+ *
+ * Build() buckets every live entity by position with a counting sort (two
+ * linear passes, no per-cell allocations; storage is reused between builds).
+ * Dense indices change on Destroy/Create, so rebuild before querying after
+ * the pool changed. Entities outside the grid land in the border cells.
+ */
+class SpatialGrid {
+public:
+    void Build(const EntityPool& pool, const Vec2& worldSize, float cellSize);
+
+    // Appends the dense index of every entity whose position is inside
+    // `area`, in ascending (pool) order.
+    void Query(const EntityPool& pool, const Aabb& area, std::vector<uint32_t>& out) const;
+
+private:
+    int CellX(float x) const;
+    int CellY(float y) const;
+
+    float m_cellSize = 128.0f;
+    int m_cellsW = 0;
+    int m_cellsH = 0;
+    std::vector<uint32_t> m_cellStart;   // cellsW * cellsH + 1 offsets into m_items
+    std::vector<uint32_t> m_items;       // dense indices grouped by cell
+    std::vector<uint32_t> m_cellOf;      // Build scratch: cell per dense index
+    std::vector<uint32_t> m_cursor;      // Build scratch: next write slot per cell
+};
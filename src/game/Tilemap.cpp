@@ -2,11 +2,16 @@
 #include "platform/SdlPlatform.h"
 #include "engine/Camera2D.h" 
 #include "game/Pathfinding.h"
+#include "engine/Counters.h"
+#include "engine/BinaryStream.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <cmath>
 
+static Counter s_tileTests("collision.tileTests");
+static Counter s_tileResolves("collision.tileResolves");
+
 int Tilemap::At(int x, int y) const {
     if (x < 0 || y < 0 || x >= m_w || y >= m_h) return 1; // outside = solid
     return m_tiles[(size_t)y * (size_t)m_w + (size_t)x];
@@ -42,6 +47,50 @@ bool Tilemap::LoadCSV(const char* path) {
     return (m_w > 0 && m_h > 0);
 }
 
+bool Tilemap::SaveCSV(const char* path) const {
+    std::ofstream f(path);
+    if (!f) return false;
+
+    for (int y = 0; y < m_h; ++y) {
+        for (int x = 0; x < m_w; ++x) {
+            if (x > 0) f << ',';
+            f << At(x, y);
+        }
+        f << '\n';
+    }
+    return (bool)f;
+}
+
+void Tilemap::Resize(int w, int h, int fill) {
+    m_w = std::max(0, w);
+    m_h = std::max(0, h);
+    m_tiles.assign((size_t)m_w * (size_t)m_h, fill);
+}
+
+void Tilemap::Save(BinaryWriter& w) const {
+    w.Write<int32_t>(m_w);
+    w.Write<int32_t>(m_h);
+    w.Write<int32_t>(m_tileSize);
+    w.WriteArray(m_tiles.data(), m_tiles.size());
+}
+
+bool Tilemap::Load(BinaryReader& r) {
+    constexpr int32_t kMaxSide = 1 << 14;
+
+    int32_t w = 0, h = 0, tileSize = 0;
+    if (!r.Read(w) || !r.Read(h) || !r.Read(tileSize)) return false;
+    if (w < 0 || h < 0 || w > kMaxSide || h > kMaxSide || tileSize <= 0 || tileSize > 1024) return false;
+
+    std::vector<int> tiles;
+    if (!r.ReadArray(tiles, (size_t)w * (size_t)h) || tiles.size() != (size_t)w * (size_t)h) return false;
+
+    m_w = w;
+    m_h = h;
+    m_tileSize = tileSize;
+    m_tiles = std::move(tiles);
+    return true;
+}
+
 bool Tilemap::IsSolidAtWorld(const Vec2& world) const {
     int tx = (int)std::floor(world.x / (float)m_tileSize);
     int ty = (int)std::floor(world.y / (float)m_tileSize);
@@ -62,6 +111,7 @@ void Tilemap::ResolveCircleCollision(Vec2& pos, float radius) const {
     for (int ty = minY; ty <= maxY; ++ty) {
         for (int tx = minX; tx <= maxX; ++tx) {
             if (At(tx, ty) != 1) continue;
+            s_tileTests.Add();
 
             float left = tx * (float)m_tileSize;
             float top = ty * (float)m_tileSize;
@@ -83,16 +133,25 @@ void Tilemap::ResolveCircleCollision(Vec2& pos, float radius) const {
                 float ny = dy / dist;
                 pos.x += nx * pen;
                 pos.y += ny * pen;
+                s_tileResolves.Add();
             }
         }
     }
 }
 
 void Tilemap::Render(SdlPlatform& platform, const Camera2D& cam) const {
-    // Render solid tiles as filled rects. (Color params depend on your API)
-    // We only draw tiles in view, but simplest first: draw all.
-    for (int y = 0; y < m_h; ++y) {
-        for (int x = 0; x < m_w; ++x) {
+    // Render solid tiles as filled rects, visiting only the tiles in view.
+    int viewW = 0, viewH = 0;
+    platform.GetWindowSize(viewW, viewH);
+    const Aabb view = cam.ViewRect(viewW, viewH);
+    const float ts = (float)m_tileSize;
+    const int x0 = std::max(0, (int)std::floor(view.min.x / ts));
+    const int y0 = std::max(0, (int)std::floor(view.min.y / ts));
+    const int x1 = std::min(m_w - 1, (int)std::floor(view.max.x / ts));
+    const int y1 = std::min(m_h - 1, (int)std::floor(view.max.y / ts));
+
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
             if (At(x, y) != 1) continue;
 
             Vec2 world{ x * (float)m_tileSize + m_tileSize * 0.5f,
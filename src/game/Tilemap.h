@@ -4,11 +4,35 @@
 #include "engine/Math.h"
 
 class SdlPlatform;
+class BinaryWriter;
+class BinaryReader;
 struct TileCoord;
 
+// Tile values used by the CSV maps (walls, floor and spawn markers).
+namespace TileId {
+    constexpr int Floor  = 0;
+    constexpr int Wall   = 1;
+    constexpr int Token  = 2;   // pickup, counts toward the win
+    constexpr int Chaser = 3;   // enemy
+    constexpr int Player = 4;
+    constexpr int Health = 5;   // pickup
+    constexpr int Speed  = 6;   // pickup
+    constexpr int Shield = 7;   // pickup
+    constexpr int Fast   = 8;   // enemy
+    constexpr int Tank   = 9;   // enemy
+}
+
 class Tilemap {
 public:
     bool LoadCSV(const char* path);
+    bool SaveCSV(const char* path) const;
+
+    // Replaces the map with w x h tiles of `fill` (map generators).
+    void Resize(int w, int h, int fill);
+
+    // Save-state support; Load leaves the map untouched on malformed data.
+    void Save(BinaryWriter& w) const;
+    bool Load(BinaryReader& r);
 
     int Width() const { return m_w; }
     int Height() const { return m_h; }
@@ -1,17 +1,187 @@
 #include "core/App.h"
+#include "core/Batch.h"
+#include "core/Scenario.h"
+#include "game/MapGen.h"
+#include "game/Tilemap.h"
+#include "engine/AllocTracker.h"
+#include "engine/Log.h"
+#include "engine/Profiler.h"
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 
-int main() {
+// --gen-map <maze|cave|arena> <width> <height> <seed> <out.csv>
+static int GenerateMapFile(char* argv[]) {
+    MapGenParams params;
+    if (!MapGen::ParseLayout(argv[0], params.layout)) {
+        LOG_ERROR(LogCategory::Core, "Unknown map layout: %s (maze, cave, arena)", argv[0]);
+        return 1;
+    }
+    params.width = std::atoi(argv[1]);
+    params.height = std::atoi(argv[2]);
+    params.seed = (uint32_t)std::strtoul(argv[3], nullptr, 10);
+
+    Tilemap map;
+    if (!MapGen::Generate(params, map) || !map.SaveCSV(argv[4])) {
+        LOG_ERROR(LogCategory::Core, "Could not generate %s", argv[4]);
+        return 1;
+    }
+    LOG_INFO(LogCategory::Core, "Wrote %s (%dx%d %s, seed %u)", argv[4], map.Width(), map.Height(),
+        MapGen::LayoutName(params.layout), params.seed);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     std::printf("Mini Engine Day 1\n");
 
+    Log::Start();
+
     App app;
     AppConfig cfg{};
+
+    // Headless scenario runs (no window): --scenario <name|all>, --scenario-map <csv>
+    std::vector<ScenarioSpec> corpus;
+    Scenario::StandardCorpus(corpus);
+    std::vector<ScenarioSpec> scenarios;
+    int scenarioTicks = 0;
+    const char* scenarioFork = nullptr;     // --scenario-fork <state>
+    const char* scenarioSave = nullptr;     // --scenario-save <prefix>: <prefix><name>.state
+    const char* scenarioHashLog = nullptr;  // --scenario-hash-log <prefix>: <prefix><name>.hashes
+    bool scenarioHash = false;              // --scenario-hash
+    const char* scenarioConfig = nullptr;   // --scenario-config <json>
+
+    // --batch <n>: n seeds of every selected scenario (all if none) on a thread pool
+    int batchCount = 0;
+    BatchOptions batch;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--gen-map") == 0 && i + 5 < argc) {
+            const int rc = GenerateMapFile(argv + i + 1);
+            Log::Stop();
+            return rc;
+        }
+        else if (std::strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            bool found = false;
+            for (const ScenarioSpec& spec : corpus) {
+                if (std::strcmp(name, "all") == 0 || spec.name == name) {
+                    scenarios.push_back(spec);
+                    found = true;
+                }
+            }
+            if (!found) LOG_WARN(LogCategory::Core, "Unknown scenario: %s", name);
+        }
+        else if (std::strcmp(argv[i], "--scenario-map") == 0 && i + 1 < argc) {
+            ScenarioSpec spec;
+            spec.name = argv[++i];
+            spec.mapPath = argv[i];
+            scenarios.push_back(spec);
+        }
+        else if (std::strcmp(argv[i], "--scenario-ticks") == 0 && i + 1 < argc) {
+            scenarioTicks = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--scenario-fork") == 0 && i + 1 < argc) {
+            scenarioFork = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--scenario-save") == 0 && i + 1 < argc) {
+            scenarioSave = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--scenario-hash") == 0) {
+            scenarioHash = true;
+        }
+        else if (std::strcmp(argv[i], "--scenario-hash-log") == 0 && i + 1 < argc) {
+            scenarioHashLog = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--scenario-config") == 0 && i + 1 < argc) {
+            scenarioConfig = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batchCount = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--batch-threads") == 0 && i + 1 < argc) {
+            batch.threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--batch-csv") == 0 && i + 1 < argc) {
+            batch.csvPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--batch-json") == 0 && i + 1 < argc) {
+            batch.jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--deterministic") == 0) {
+            cfg.deterministic = true;
+        }
+        else if (std::strcmp(argv[i], "--hash-log") == 0 && i + 1 < argc) {
+            cfg.hashLogPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--load-state") == 0 && i + 1 < argc) {
+            cfg.loadStatePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--save-state") == 0 && i + 1 < argc) {
+            cfg.statePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--render-size") == 0 && i + 2 < argc) {
+            cfg.renderWidth = std::atoi(argv[++i]);
+            cfg.renderHeight = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--dynamic-res") == 0 && i + 1 < argc) {
+            cfg.dynamicResolution = true;
+            cfg.dynamicResTargetMs = (float)std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--alloc-report") == 0 && i + 1 < argc) {
+            cfg.allocReportPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            cfg.tracePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--trace-seconds") == 0 && i + 1 < argc) {
+            cfg.traceSeconds = (float)std::atof(argv[++i]);
+        }
+        else {
+            LOG_WARN(LogCategory::Core, "Unknown argument: %s", argv[i]);
+        }
+    }
+
+    if (batchCount > 0 && scenarios.empty()) scenarios = corpus;
+
+    if (!scenarios.empty()) {
+        if (batchCount > 0) {
+            std::vector<ScenarioSpec> jobs;
+            Batch::Expand(scenarios, batchCount, jobs);
+            scenarios.swap(jobs);
+        }
+        // Output paths come from the final (expanded) names so no two jobs share a file.
+        for (ScenarioSpec& spec : scenarios) {
+            if (scenarioTicks > 0) spec.ticks = scenarioTicks;
+            if (scenarioFork) spec.startStatePath = scenarioFork;
+            if (scenarioSave) spec.endStatePath = std::string(scenarioSave) + spec.name + ".state";
+            if (scenarioHashLog) spec.hashLogPath = std::string(scenarioHashLog) + spec.name + ".hashes";
+            if (scenarioConfig) spec.configPath = scenarioConfig;
+            spec.hashState = scenarioHash;
+        }
+        int failed = 0;
+        if (batchCount > 0) {
+            failed = Batch::Run(scenarios, batch);
+        }
+        else {
+            failed = Scenario::RunAll(scenarios);
+        }
+        // App::Shutdown writes these for windowed runs. Batch workers record
+        // no profiler zones, so there a trace only covers setup.
+        if (cfg.tracePath) Profiler::WriteChromeTrace(cfg.tracePath, cfg.traceSeconds);
+        if (cfg.allocReportPath) AllocTracker::WriteReport(cfg.allocReportPath);
+        Log::Stop();
+        return failed > 0 ? 1 : 0;
+    }
+
     if (!app.Init(cfg)) {
-        std::printf("[FATAL] Init failed\n");
+        LOG_ERROR(LogCategory::Core, "Init failed");
+        Log::Stop();
         return 1;
     }
 
     app.Run();
     app.Shutdown();
+    Log::Stop();
     return 0;
 }
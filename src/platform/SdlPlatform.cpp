@@ -1,11 +1,17 @@
 #include "platform/SdlPlatform.h"
 #include "platform/SdlTexture.h"
+#include "engine/Counters.h"
+#include "engine/Log.h"
 
 #include <SDL.h>
 #include <algorithm>
 #include <cstdio>
 #include <cmath>
 
+static Counter s_drawSprites("draw.sprites");
+static Counter s_drawLines("draw.lines");
+static Counter s_drawRects("draw.rects");
+
 bool SdlPlatform::Init(int windowW, int windowH, const char* title) {
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0) {
         std::printf("[ERROR] SDL_Init failed: %s\n", SDL_GetError());
@@ -46,7 +52,21 @@ bool SdlPlatform::Init(int windowW, int windowH, const char* title) {
     return true;
 }
 
+bool SdlPlatform::InitHeadless(int viewW, int viewH) {
+    // No SDL_Init/SDL_Quit: they're process-wide, and batch runs keep many
+    // headless platforms alive on different threads. The performance
+    // counter works without them.
+    m_headless = true;
+    m_headlessW = viewW;
+    m_headlessH = viewH;
+
+    m_perfFreq = static_cast<std::uint64_t>(SDL_GetPerformanceFrequency());
+    m_prevCounter = static_cast<std::uint64_t>(SDL_GetPerformanceCounter());
+    return true;
+}
+
 void SdlPlatform::Shutdown() {
+    SetRenderResolution(0, 0);
     if (m_renderer) {
         SDL_DestroyRenderer(m_renderer);
         m_renderer = nullptr;
@@ -55,7 +75,7 @@ void SdlPlatform::Shutdown() {
         SDL_DestroyWindow(m_window);
         m_window = nullptr;
     }
-    SDL_Quit();
+    if (!m_headless) SDL_Quit();
 }
 
 bool SdlPlatform::Pump(SdlFrameData& outFrame) {
@@ -69,13 +89,20 @@ bool SdlPlatform::Pump(SdlFrameData& outFrame) {
         : 0.0f;
 
     // Clamp dt to avoid extreme simulation steps after a debugger pause.
-    dt = std::clamp(dt, 0.0f, 0.1f);
+    const float rawDt = dt;
+    dt = std::clamp(dt, 0.0f, m_maxFrameDt);
 
     m_timeSeconds += dt;
 
     outFrame.dtSeconds = dt;
+    outFrame.clampedSeconds = std::max(0.0f, rawDt - dt);
     outFrame.timeSeconds = m_timeSeconds;
 
+    if (m_headless) {
+        outFrame.input = Input{};
+        return true;
+    }
+
     // ---- Events ----
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
@@ -100,59 +127,140 @@ bool SdlPlatform::Pump(SdlFrameData& outFrame) {
     outFrame.input.SetKey(Key::Tab, keys[SDL_SCANCODE_TAB] != 0);
     outFrame.input.SetKey(Key::R, keys[SDL_SCANCODE_R] != 0);
     outFrame.input.SetKey(Key::Return, keys[SDL_SCANCODE_RETURN] != 0);
+    outFrame.input.SetKey(Key::F9, keys[SDL_SCANCODE_F9] != 0);
 
 
     // Occasional logging for sanity (once per second).
-    static float logTimer = 0.0f;
-    logTimer += dt;
-    if (logTimer >= 1.0f) {
-        logTimer = 0.0f;
-        std::printf("[INFO] dt=%.4f t=%.2f WASD=%d%d%d%d\n",
-            outFrame.dtSeconds, outFrame.timeSeconds,
-            (int)outFrame.input.Down(Key::W),
-            (int)outFrame.input.Down(Key::A),
-            (int)outFrame.input.Down(Key::S),
-            (int)outFrame.input.Down(Key::D));
-    }
+    LOG_EVERY(1.0f, LogLevel::Debug, LogCategory::Platform, "dt=%.4f t=%.2f WASD=%d%d%d%d",
+        outFrame.dtSeconds, outFrame.timeSeconds,
+        (int)outFrame.input.Down(Key::W),
+        (int)outFrame.input.Down(Key::A),
+        (int)outFrame.input.Down(Key::S),
+        (int)outFrame.input.Down(Key::D));
 
     return true;
 }
 
 void SdlPlatform::BeginFrame() {
+    if (!m_renderer) return;
+    if (m_sceneTarget) {
+        // Setting a target resets its scale; the scale shrinks what we draw
+        // into the top-left share of the texture.
+        SDL_SetRenderTarget(m_renderer, m_sceneTarget);
+        SDL_RenderSetScale(m_renderer, m_renderScale, m_renderScale);
+        m_sceneOpen = true;
+    }
     SDL_SetRenderDrawColor(m_renderer, 15, 15, 18, 255);
     SDL_RenderClear(m_renderer);
 }
 
 void SdlPlatform::EndFrame() {
+    if (!m_renderer) return;
+    ResolveScene();
     SDL_RenderPresent(m_renderer);
 }
 
+bool SdlPlatform::SetRenderResolution(int logicalW, int logicalH) {
+    if (m_sceneTarget) {
+        SDL_DestroyTexture(m_sceneTarget);
+        m_sceneTarget = nullptr;
+    }
+    m_sceneW = 0;
+    m_sceneH = 0;
+    m_sceneOpen = false;
+    if (logicalW <= 0 || logicalH <= 0 || !m_renderer) return true;
+
+    if (!SDL_RenderTargetSupported(m_renderer)) {
+        LOG_WARN(LogCategory::Platform, "Renderer has no render targets; drawing at native resolution");
+        return false;
+    }
+    m_sceneTarget = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, logicalW, logicalH);
+    if (!m_sceneTarget) {
+        LOG_WARN(LogCategory::Platform, "Could not create %dx%d render target: %s", logicalW, logicalH, SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureScaleMode(m_sceneTarget, SDL_ScaleModeNearest);
+    m_sceneW = logicalW;
+    m_sceneH = logicalH;
+    LOG_INFO(LogCategory::Platform, "Rendering at %dx%d (upscaled)", logicalW, logicalH);
+    return true;
+}
+
+void SdlPlatform::SetRenderScale(float scale) {
+    m_renderScale = std::clamp(scale, 0.25f, 1.0f);
+}
+
+void SdlPlatform::ResolveScene() {
+    if (!m_sceneOpen) return;
+    m_sceneOpen = false;
+
+    // Switching back to the window flushes the batched scene draws.
+    SDL_SetRenderTarget(m_renderer, nullptr);
+    SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 255);
+    SDL_RenderClear(m_renderer);
+
+    int outW = 0, outH = 0;
+    SDL_GetRendererOutputSize(m_renderer, &outW, &outH);
+    const int scale = std::max(1, std::min(outW / m_sceneW, outH / m_sceneH));
+    const int dstW = std::min(outW, m_sceneW * scale);
+    const int dstH = std::min(outH, m_sceneH * scale);
+
+    const SDL_Rect src{ 0, 0,
+        std::max(1, (int)std::ceil(m_sceneW * m_renderScale)),
+        std::max(1, (int)std::ceil(m_sceneH * m_renderScale)) };
+    const SDL_Rect dst{ (outW - dstW) / 2, (outH - dstH) / 2, dstW, dstH };
+    SDL_RenderCopy(m_renderer, m_sceneTarget, &src, &dst);
+}
+
 void SdlPlatform::GetWindowSize(int& outW, int& outH) const {
     outW = 0;
     outH = 0;
-    if (m_window) {
+    if (m_headless) {
+        outW = m_headlessW;
+        outH = m_headlessH;
+    }
+    else if (m_sceneTarget) {
+        outW = m_sceneW;
+        outH = m_sceneH;
+    }
+    else if (m_window) {
         SDL_GetWindowSize(m_window, &outW, &outH);
     }
 }
 
 void SdlPlatform::DrawSprite(const SdlTexture& tex, int x, int y) {
     SDL_Texture* t = tex.Raw();
-    if (!t) return;
+    if (!t || !m_renderer) return;
 
     SDL_Rect dst{ x, y, tex.Width(), tex.Height() };
     SDL_RenderCopy(m_renderer, t, nullptr, &dst);
+    s_drawSprites.Add();
+}
+
+void SdlPlatform::DrawSprite(const SdlTexture& tex, int srcX, int srcY, int w, int h, int x, int y) {
+    SDL_Texture* t = tex.Raw();
+    if (!t || !m_renderer) return;
+
+    SDL_Rect src{ srcX, srcY, w, h };
+    SDL_Rect dst{ x, y, w, h };
+    SDL_RenderCopy(m_renderer, t, &src, &dst);
+    s_drawSprites.Add();
 }
 
 void SdlPlatform::DrawLine(int x1, int y1, int x2, int y2) {
+    if (!m_renderer) return;
     SDL_SetRenderDrawColor(m_renderer, 40, 40, 50, 255);
     SDL_RenderDrawLine(m_renderer, x1, y1, x2, y2);
+    s_drawLines.Add();
 }
 
 void SdlPlatform::DrawFilledRect(int x, int y, int w, int h,
                                  std::uint8_t r, std::uint8_t g, std::uint8_t b) {
+    if (!m_renderer) return;
     SDL_SetRenderDrawColor(m_renderer, r, g, b, 255);
     SDL_Rect rc{ x, y, w, h };
     SDL_RenderFillRect(m_renderer, &rc);
+    s_drawRects.Add();
 }
 
 // (Removed) legacy debug test rect helper.
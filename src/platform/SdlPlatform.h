@@ -5,6 +5,7 @@
 // Forward declarations to avoid pulling SDL headers into the public interface.
 struct SDL_Window;
 struct SDL_Renderer;
+struct SDL_Texture;
 class SdlTexture;
 
 /**
@@ -13,6 +14,7 @@ class SdlTexture;
 struct SdlFrameData {
     float dtSeconds = 0.0f;     // time since last frame (seconds)
     float timeSeconds = 0.0f;   // running time since start (seconds)
+    float clampedSeconds = 0.0f; // real time discarded by the dt clamp this frame
     Input input;               // current input snapshot
 };
 
@@ -26,21 +28,47 @@ struct SdlFrameData {
 class SdlPlatform {
 public:
     bool Init(int windowW, int windowH, const char* title);
+    // No window or renderer (scenario runs, CI): timing works, Pump reports
+    // no input, draw calls are dropped and the "window" is viewW x viewH.
+    // Touches no global SDL state, so any thread may own one.
+    bool InitHeadless(int viewW, int viewH);
     void Shutdown();
 
+    bool IsHeadless() const { return m_headless; }
+
     // Returns false when the app should quit.
     bool Pump(SdlFrameData& outFrame);
 
+    // Upper bound for the per-frame dt reported by Pump.
+    void SetMaxFrameDt(float seconds) { m_maxFrameDt = seconds; }
+
     // Frame lifecycle
     void BeginFrame();
     void EndFrame();
 
+    // Low-res mode: the scene is drawn into a logicalW x logicalH target
+    // texture (the size GetWindowSize reports) and ResolveScene upscales it
+    // by the largest integer factor that fits the window, nearest-filtered
+    // and letterboxed. Scene fill cost no longer depends on the display.
+    // 0 x 0 renders natively. False if the renderer has no target support.
+    bool SetRenderResolution(int logicalW, int logicalH);
+    // Dynamic resolution: only this share of the target (per axis) is
+    // rendered and stretched to the same output rect. Clamped to [0.25, 1].
+    void SetRenderScale(float scale);
+    float RenderScale() const { return m_renderScale; }
+    bool HasSceneTarget() const { return m_sceneTarget != nullptr; }
+    // Ends scene drawing (flushes it) and copies it to the window; anything
+    // drawn afterwards (debug UI) is native resolution. No-op without a target.
+    void ResolveScene();
+
     // Query helpers
     void GetWindowSize(int& outW, int& outH) const;
     SDL_Renderer* RendererRaw() const { return m_renderer; }
 
     // Drawing helpers (screen-space)
     void DrawSprite(const SdlTexture& tex, int x, int y);
+    // Draws the (srcX, srcY, w, h) region of tex (e.g. an atlas sprite) at x, y.
+    void DrawSprite(const SdlTexture& tex, int srcX, int srcY, int w, int h, int x, int y);
     void DrawLine(int x1, int y1, int x2, int y2);
     void DrawFilledRect(int x, int y, int w, int h,
                         std::uint8_t r, std::uint8_t g, std::uint8_t b);
@@ -55,9 +83,20 @@ private:
     SDL_Window*   m_window = nullptr;
     SDL_Renderer* m_renderer = nullptr;
 
+    SDL_Texture*  m_sceneTarget = nullptr;  // low-res mode only
+    int           m_sceneW = 0;
+    int           m_sceneH = 0;
+    float         m_renderScale = 1.0f;
+    bool          m_sceneOpen = false;      // target bound, not yet resolved
+
     std::uint64_t m_perfFreq = 0;
     std::uint64_t m_prevCounter = 0;
     float         m_timeSeconds = 0.0f;
+    float         m_maxFrameDt = 0.1f;
+
+    bool m_headless = false;
+    int  m_headlessW = 0;
+    int  m_headlessH = 0;
 
     SdlEventCallback m_eventCb = nullptr;
     void* m_eventUser = nullptr;
@@ -1,30 +1,39 @@
 #include "platform/SdlTexture.h"
 #include "platform/SdlPlatform.h"
 #include <SDL.h>
-#include <cstdio>
+#include "engine/Log.h"
 
 bool SdlTexture::LoadBMP(SdlPlatform& platform, const char* path) {
-    Destroy();
-
     SDL_Surface* surf = SDL_LoadBMP(path);
     if (!surf) {
-        std::printf("[ERROR] SDL_LoadBMP failed (%s): %s\n", path, SDL_GetError());
+        LOG_ERROR(LogCategory::Assets, "SDL_LoadBMP failed (%s): %s", path, SDL_GetError());
         return false;
     }
 
-    m_w = surf->w;
-    m_h = surf->h;
-
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(platform.RendererRaw(), surf);
+    const bool ok = CreateFromSurface(platform, surf);
     SDL_FreeSurface(surf);
 
+    if (ok) {
+        LOG_INFO(LogCategory::Assets, "Loaded BMP: %s (%dx%d)", path, m_w, m_h);
+    }
+    return ok;
+}
+
+bool SdlTexture::CreateFromSurface(SdlPlatform& platform, SDL_Surface* surf) {
+    if (!surf) return false;
+
+    // Keep the current texture until the replacement exists, so a failed
+    // re-upload leaves the old image drawable.
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(platform.RendererRaw(), surf);
     if (!tex) {
-        std::printf("[ERROR] SDL_CreateTextureFromSurface failed: %s\n", SDL_GetError());
+        LOG_ERROR(LogCategory::Assets, "SDL_CreateTextureFromSurface failed: %s", SDL_GetError());
         return false;
     }
 
+    Destroy();
     m_tex = tex;
-    std::printf("[INFO] Loaded BMP: %s (%dx%d)\n", path, m_w, m_h);
+    m_w = surf->w;
+    m_h = surf->h;
     return true;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 struct SDL_Texture;
+struct SDL_Surface;
 class SdlPlatform;
 
 /**
@@ -10,6 +11,10 @@ class SdlPlatform;
 class SdlTexture {
 public:
     bool LoadBMP(SdlPlatform& platform, const char* path);
+
+    // Uploads an already-decoded surface (render thread only). Does not free surf.
+    // On failure the previous texture, if any, is kept.
+    bool CreateFromSurface(SdlPlatform& platform, SDL_Surface* surf);
     void Destroy();
 
     int Width() const { return m_w; }